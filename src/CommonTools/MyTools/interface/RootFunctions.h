@@ -12,9 +12,21 @@
 namespace my {
 
   /// Generic function base class
+  /// Besides the point-wise 'operator()' as used by TF1, all functions provide
+  /// - 'Eval(...)': evaluation for an array of x values with the same parameters and
+  /// - 'Gradient(...)': the derivatives with respect to all parameters at x.
+  /// The functions keep no state between calls, so one object can be used by several threads.
   class Function {
     public:
+      virtual ~Function() {};
       virtual Double_t operator()( Double_t * x, Double_t * par ) = 0;
+      /// Number of parameters
+      virtual Int_t NParameters() const = 0;
+      /// Evaluates the function for the 'n' values in 'x' into 'values'
+      virtual void Eval( Int_t n, const Double_t * x, Double_t * par, Double_t * values );
+      /// Derivatives with respect to the NParameters() parameters at x into 'grad';
+      /// numerical (central differences), if not implemented analytically
+      virtual void Gradient( Double_t * x, Double_t * par, Double_t * grad );
   };
 
   /// Generic resolution function base class
@@ -37,6 +49,9 @@ namespace my {
       virtual Double_t operator()( Double_t * x, Double_t * par );
       inline static Int_t NPar() { return 2; };
       inline static std::string String() { return std::string( "[0]+[1]*x" ); };
+      virtual Int_t NParameters() const { return NPar(); };
+      virtual void Eval( Int_t n, const Double_t * x, Double_t * par, Double_t * values );
+      virtual void Gradient( Double_t * x, Double_t * par, Double_t * grad );
   };
 
   /// Parabola with the following parameters:
@@ -48,6 +63,9 @@ namespace my {
       virtual Double_t operator()( Double_t * x, Double_t * par );
       inline static Int_t NPar() { return 3; };
       inline static std::string String() { return std::string( "[0]+[1]*x+[2]*x**2" ); };
+      virtual Int_t NParameters() const { return NPar(); };
+      virtual void Eval( Int_t n, const Double_t * x, Double_t * par, Double_t * values );
+      virtual void Gradient( Double_t * x, Double_t * par, Double_t * grad );
   };
 
   /// Resolution function for x>=0. with the following parameters:
@@ -60,6 +78,9 @@ namespace my {
       virtual Double_t operator()( Double_t * x, Double_t * par );
       inline static Int_t NPar() { return 3; };
       inline static std::string String() { return std::string( "sqrt([0]**2+[1]**2*x+[2]**2*x**2)" ); };
+      virtual Int_t NParameters() const { return NPar(); };
+      virtual void Eval( Int_t n, const Double_t * x, Double_t * par, Double_t * values );
+      virtual void Gradient( Double_t * x, Double_t * par, Double_t * grad );
   };
 
 }
@@ -79,6 +100,9 @@ namespace my {
       inline static Int_t NPar() { return 3; };
       inline static std::string String() { return std::string( "[0]*exp(-0.5*((x-[1])/[2])**2)/([2]*sqrt(2*pi))" ); };
       virtual Double_t Sigma( Double_t * par ) { return par[ 2 ]; };
+      virtual Int_t NParameters() const { return NPar(); };
+      virtual void Eval( Int_t n, const Double_t * x, Double_t * par, Double_t * values );
+      virtual void Gradient( Double_t * x, Double_t * par, Double_t * grad );
   };
 
   /// Normalised double Gaussian with the following parameters:
@@ -95,6 +119,29 @@ namespace my {
       inline static Int_t NPar() { return 6; };
       inline static std::string String() { return std::string( "[0]*(exp(-0.5*((x-[1])/[2])**2)+[3]*exp(-0.5*((x-[4])/[5])**2))/(([2]+[3]*[5])*sqrt(2*pi))" ); };
       virtual Double_t Sigma( Double_t * par ) { return par[ 2 ] + par[ 3 ] * par[ 5 ]; };
+      virtual Int_t NParameters() const { return NPar(); };
+      virtual void Eval( Int_t n, const Double_t * x, Double_t * par, Double_t * values );
+      virtual void Gradient( Double_t * x, Double_t * par, Double_t * grad );
+  };
+
+  /// Constants of a Crystal Ball power law tail with transition position 'alpha' and power 'power'
+  /// and their derivatives, computed once per call of 'Eval(...)' or 'Gradient(...)'
+  class CrystalBallTail {
+    public:
+      CrystalBallTail( Double_t alpha, Double_t power );
+      Double_t a_;        // |alpha|
+      Double_t sign_;     // d|alpha|/d(alpha)
+      Double_t A_;        // (power/a)^power * exp(-a^2/2)
+      Double_t B_;        // power/a - a
+      Double_t C_;        // tail contribution to the normalisation
+      Double_t Erf_;      // core contribution to the normalisation (w/o constant factor)
+      Double_t dLnAda_;
+      Double_t dLnAdn_;
+      Double_t dBda_;
+      Double_t dBdn_;
+      Double_t dCda_;
+      Double_t dCdn_;
+      Double_t dErfda_;
   };
 
   /// Normalised low sided Crystal Ball function with the following parameters:
@@ -110,6 +157,9 @@ namespace my {
       inline static Int_t NPar() { return 5; };
       inline static std::string String() { return std::string( "" ); };
       virtual Double_t Sigma( Double_t * par ) { return par[ 2 ]; };
+      virtual Int_t NParameters() const { return NPar(); };
+      virtual void Eval( Int_t n, const Double_t * x, Double_t * par, Double_t * values );
+      virtual void Gradient( Double_t * x, Double_t * par, Double_t * grad );
   };
 
   /// Normalised high sided Crystal Ball function with the following parameters:
@@ -125,6 +175,9 @@ namespace my {
       inline static Int_t NPar() { return 5; };
       inline static std::string String() { return std::string( "" ); };
       virtual Double_t Sigma( Double_t * par ) { return par[ 2 ]; };
+      virtual Int_t NParameters() const { return NPar(); };
+      virtual void Eval( Int_t n, const Double_t * x, Double_t * par, Double_t * values );
+      virtual void Gradient( Double_t * x, Double_t * par, Double_t * grad );
   };
 
   /// Normalised double sided Crystal Ball function with the following parameters:
@@ -142,6 +195,9 @@ namespace my {
       inline static Int_t NPar() { return 7; };
       inline static std::string String() { return std::string( "" ); };
       virtual Double_t Sigma( Double_t * par ) { return par[ 2 ]; };
+      virtual Int_t NParameters() const { return NPar(); };
+      virtual void Eval( Int_t n, const Double_t * x, Double_t * par, Double_t * values );
+      virtual void Gradient( Double_t * x, Double_t * par, Double_t * grad );
   };
 
 }
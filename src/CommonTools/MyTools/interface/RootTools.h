@@ -2,13 +2,31 @@
 #define CommonTools_MyTools_RootTools_h
 
 
+#include <string>
+#include <vector>
+
 #include "TStyle.h"
+#include "TTree.h"
 
 
 namespace my {
 
   void setPlotEnvironment( TStyle * style );
 
+  /// Reads all values of the branch 'name' of 'tree' into 'column'
+  /// The branch can hold a scalar ('/D', '/F' or '/I') per entry or a vector
+  /// ('std::vector< double >' or 'std::vector< int >') of values per entry,
+  /// as in the columnar n-tuples of AnalyzeHitFit; only this branch is read.
+  /// Returns false, if the branch is missing or of an unknown type.
+  /// A branch address set by the caller and the value of the caller's
+  /// variable at this address are restored afterwards.
+  bool readColumn( TTree * tree, const std::string & name, std::vector< Double_t > & column );
+
+  /// Reads the branches 'names' of 'tree' with readColumn() into 'columns'
+  /// (in the same order)
+  /// Returns false, if a branch cannot be read or the columns differ in length.
+  bool readColumns( TTree * tree, const std::vector< std::string > & names, std::vector< std::vector< Double_t > > & columns );
+
 }
 
 
@@ -1,31 +1,155 @@
 #include "CommonTools/MyTools/interface/RootFunctions.h"
 
+#include <vector>
+
 #include "TMath.h"
 
 
+namespace {
+
+  /// Logarithmic derivatives of the Crystal Ball power law tail f = A * ( B + side * E )^-n
+  /// with respect to E, |alpha| and n in 'dLn'; 'side' is -1. for the lower and +1. for the upper tail
+  void tailLogDerivatives( const my::CrystalBallTail & tail, Double_t power, Double_t side, Double_t E, Double_t * dLn )
+  {
+
+    Double_t t( tail.B_ + side * E );
+
+    dLn[ 0 ] = -side * power / t;
+    dLn[ 1 ] = tail.dLnAda_ - power * tail.dBda_ / t;
+    dLn[ 2 ] = tail.dLnAdn_ - TMath::Log( t ) - power * tail.dBdn_ / t;
+
+  }
+
+  /// Fills 'grad' with the derivatives with respect to normalisation factor, mean and sigma
+  /// of a Crystal Ball like function 'value' = p0 / ( S * 'norm' ) * 'shape' with d ln( 'shape' ) / dE = 'dLnShapedE'
+  void coreGradient( Double_t E, Double_t S, Double_t norm, Double_t shape, Double_t value, Double_t dLnShapedE, Double_t * grad )
+  {
+
+    grad[ 0 ] = shape / ( S * norm );
+    grad[ 1 ] = -value * dLnShapedE / S;
+    grad[ 2 ] = -value * ( 1. + dLnShapedE * E ) / S;
+
+  }
+
+}
+
+
+void my::Function::Eval( Int_t n, const Double_t * x, Double_t * par, Double_t * values )
+{
+
+  for ( Int_t i = 0; i < n; ++i ) {
+    Double_t xi( x[ i ] );
+    values[ i ] = operator()( &xi, par );
+  }
+
+}
+
+
+void my::Function::Gradient( Double_t * x, Double_t * par, Double_t * grad )
+{
+
+  std::vector< Double_t > shifted( par, par + NParameters() );
+  for ( Int_t i = 0; i < NParameters(); ++i ) {
+    Double_t h( 1.e-6 * TMath::Max( TMath::Abs( par[ i ] ), 1. ) );
+    shifted[ i ] = par[ i ] + h;
+    Double_t up( operator()( x, &shifted.front() ) );
+    shifted[ i ] = par[ i ] - h;
+    Double_t down( operator()( x, &shifted.front() ) );
+    shifted[ i ] = par[ i ];
+    grad[ i ] = ( up - down ) / ( 2. * h );
+  }
+
+}
+
+
+my::CrystalBallTail::CrystalBallTail( Double_t alpha, Double_t power )
+{
+
+  a_    = TMath::Abs( alpha );
+  sign_ = alpha < 0. ? -1. : 1.;
+  Double_t ratio( power / a_ );
+  Double_t gauss( TMath::Exp( -0.5 * a_ * a_ ) );
+
+  A_   = TMath::Power( ratio, power ) * gauss;
+  B_   = ratio - a_;
+  C_   = ratio * ( 1. / ( power - 1. ) ) * gauss;
+  Erf_ = TMath::Erf( a_ / TMath::Sqrt( TMath::Pi() ) );
+
+  dLnAda_ = -ratio - a_;
+  dLnAdn_ = TMath::Log( ratio ) + 1.;
+  dBda_   = -ratio / a_ - 1.;
+  dBdn_   = 1. / a_;
+  dCda_   = C_ * ( -1. / a_ - a_ );
+  dCdn_   = C_ * ( 1. / power - 1. / ( power - 1. ) );
+  dErfda_ = 2. / TMath::Pi() * TMath::Exp( -a_ * a_ / TMath::Pi() );
+
+}
+
+
 Double_t my::Line::operator()( Double_t * x, Double_t * par )
+{
+
+  Double_t value;
+  Eval( 1, x, par, &value );
+
+  return value;
+
+}
+
+
+void my::Line::Eval( Int_t n, const Double_t * x, Double_t * par, Double_t * values )
 {
 
   Double_t A( par[ 0 ] );
   Double_t B( par[ 1 ] );
 
-  Double_t value( A + B * x[ 0 ] );
+  for ( Int_t i = 0; i < n; ++i ) {
+    values[ i ] = A + B * x[ i ];
+  }
 
-  return value;
+}
+
+
+void my::Line::Gradient( Double_t * x, Double_t * par, Double_t * grad )
+{
+
+  grad[ 0 ] = 1.;
+  grad[ 1 ] = x[ 0 ];
 
 }
 
 
 Double_t my::Parabola::operator()( Double_t * x, Double_t * par )
+{
+
+  Double_t value;
+  Eval( 1, x, par, &value );
+
+  return value;
+
+}
+
+
+void my::Parabola::Eval( Int_t n, const Double_t * x, Double_t * par, Double_t * values )
 {
 
   Double_t A( par[ 0 ] );
   Double_t B( par[ 1 ] );
   Double_t C( par[ 2 ] );
 
-  Double_t value( A + B * x[ 0 ] + C * TMath::Power( x[ 0 ], 2. ) );
+  for ( Int_t i = 0; i < n; ++i ) {
+    values[ i ] = A + ( B + C * x[ i ] ) * x[ i ];
+  }
 
-  return value;
+}
+
+
+void my::Parabola::Gradient( Double_t * x, Double_t * par, Double_t * grad )
+{
+
+  grad[ 0 ] = 1.;
+  grad[ 1 ] = x[ 0 ];
+  grad[ 2 ] = x[ 0 ] * x[ 0 ];
 
 }
 
@@ -33,17 +157,42 @@ Double_t my::Parabola::operator()( Double_t * x, Double_t * par )
 Double_t my::ResolutionLike::operator()( Double_t * x, Double_t * par )
 {
 
-  Double_t value( -1.);
+  Double_t value;
+  Eval( 1, x, par, &value );
+
+  return value;
+
+}
 
-  Double_t N( par[ 0 ] );
-  Double_t R( par[ 1 ] );
-  Double_t C( par[ 2 ] );
 
-  if ( x[ 0 ] >= 0. ) {
-    value = TMath::Sqrt( TMath::Power( N, 2. ) + TMath::Power( R, 2. ) * x[ 0 ] + TMath::Power( C, 2. ) * TMath::Power( x[ 0 ], 2. ) );
+void my::ResolutionLike::Eval( Int_t n, const Double_t * x, Double_t * par, Double_t * values )
+{
+
+  Double_t N2( par[ 0 ] * par[ 0 ] );
+  Double_t R2( par[ 1 ] * par[ 1 ] );
+  Double_t C2( par[ 2 ] * par[ 2 ] );
+
+  for ( Int_t i = 0; i < n; ++i ) {
+    values[ i ] = x[ i ] >= 0. ? TMath::Sqrt( N2 + ( R2 + C2 * x[ i ] ) * x[ i ] ) : -1.;
   }
 
-  return value;
+}
+
+
+void my::ResolutionLike::Gradient( Double_t * x, Double_t * par, Double_t * grad )
+{
+
+  grad[ 0 ] = 0.;
+  grad[ 1 ] = 0.;
+  grad[ 2 ] = 0.;
+
+  Double_t value( operator()( x, par ) );
+
+  if ( value > 0. ) {
+    grad[ 0 ] = par[ 0 ] / value;
+    grad[ 1 ] = par[ 1 ] * x[ 0 ] / value;
+    grad[ 2 ] = par[ 2 ] * x[ 0 ] * x[ 0 ] / value;
+  }
 
 }
 
@@ -51,25 +200,101 @@ Double_t my::ResolutionLike::operator()( Double_t * x, Double_t * par )
 Double_t my::SingleGaussian::operator()( Double_t * x, Double_t * par )
 {
 
-  Double_t value( -1.);
+  Double_t value;
+  Eval( 1, x, par, &value );
+
+  return value;
+
+}
+
+
+void my::SingleGaussian::Eval( Int_t n, const Double_t * x, Double_t * par, Double_t * values )
+{
+
+  Double_t N( par[ 0 ] );
+  Double_t M( par[ 1 ] );
+  Double_t S( par[ 2 ] );
+
+  if ( ! ( N >= 0. && S > 0. ) ) {
+    for ( Int_t i = 0; i < n; ++i ) values[ i ] = -1.;
+    return;
+  }
+
+  Double_t norm( N / ( S * TMath::Sqrt( TMath::TwoPi() ) ) );
+  Double_t invS( 1. / S );
+
+  for ( Int_t i = 0; i < n; ++i ) {
+    Double_t u( ( x[ i ] - M ) * invS );
+    values[ i ] = norm * TMath::Exp( -0.5 * u * u );
+  }
+
+}
+
+
+void my::SingleGaussian::Gradient( Double_t * x, Double_t * par, Double_t * grad )
+{
+
+  for ( Int_t i = 0; i < NPar(); ++i ) grad[ i ] = 0.;
 
   Double_t N( par[ 0 ] );
   Double_t M( par[ 1 ] );
   Double_t S( par[ 2 ] );
 
   if ( N >= 0. && S > 0. ) {
-    value = N * TMath::Exp( -0.5 * TMath::Power( ( x[ 0 ] - M ) / S, 2. ) ) / ( S * TMath::Sqrt( TMath::TwoPi() ) );
+    Double_t u( ( x[ 0 ] - M ) / S );
+    Double_t g( TMath::Exp( -0.5 * u * u ) / ( S * TMath::Sqrt( TMath::TwoPi() ) ) );
+    Double_t value( N * g );
+    grad[ 0 ] = g;
+    grad[ 1 ] = value * u / S;
+    grad[ 2 ] = value * ( u * u - 1. ) / S;
   }
 
+}
+
+
+Double_t my::DoubleGaussian::operator()( Double_t * x, Double_t * par )
+{
+
+  Double_t value;
+  Eval( 1, x, par, &value );
+
   return value;
 
 }
 
 
-Double_t my::DoubleGaussian::operator()( Double_t * x, Double_t * par )
+void my::DoubleGaussian::Eval( Int_t n, const Double_t * x, Double_t * par, Double_t * values )
+{
+
+  Double_t N0( par[ 0 ] );
+  Double_t M1( par[ 1 ] );
+  Double_t S1( par[ 2 ] );
+  Double_t N2( par[ 3 ] );
+  Double_t M2( par[ 4 ] );
+  Double_t S2( par[ 5 ] );
+
+  if ( ! ( N0 >= 0. && S1 > 0. && N2 >= 0. && S2 > 0. ) ) {
+    for ( Int_t i = 0; i < n; ++i ) values[ i ] = -1.;
+    return;
+  }
+
+  Double_t norm( N0 / ( ( S1 + N2 * S2 ) * TMath::Sqrt( TMath::TwoPi() ) ) );
+  Double_t invS1( 1. / S1 );
+  Double_t invS2( 1. / S2 );
+
+  for ( Int_t i = 0; i < n; ++i ) {
+    Double_t u1( ( x[ i ] - M1 ) * invS1 );
+    Double_t u2( ( x[ i ] - M2 ) * invS2 );
+    values[ i ] = norm * ( TMath::Exp( -0.5 * u1 * u1 ) + N2 * TMath::Exp( -0.5 * u2 * u2 ) );
+  }
+
+}
+
+
+void my::DoubleGaussian::Gradient( Double_t * x, Double_t * par, Double_t * grad )
 {
 
-  Double_t value( -1.);
+  for ( Int_t i = 0; i < NPar(); ++i ) grad[ i ] = 0.;
 
   Double_t N0( par[ 0 ] );
   Double_t M1( par[ 1 ] );
@@ -79,99 +304,257 @@ Double_t my::DoubleGaussian::operator()( Double_t * x, Double_t * par )
   Double_t S2( par[ 5 ] );
 
   if ( N0 >= 0. && S1 > 0. && N2 >= 0. && S2 > 0. ) {
-    value = N0 * ( TMath::Exp( -0.5 * TMath::Power( ( x[ 0 ] - M1 ) / S1 , 2. ) ) + N2 * TMath::Exp( -0.5 * TMath::Power( ( x[ 0 ] - M2 ) / S2, 2. ) ) ) / ( ( S1 + N2 * S2 )*TMath::Sqrt( TMath::TwoPi() ) );
+    Double_t sum( S1 + N2 * S2 );
+    Double_t K( 1. / ( sum * TMath::Sqrt( TMath::TwoPi() ) ) );
+    Double_t u1( ( x[ 0 ] - M1 ) / S1 );
+    Double_t u2( ( x[ 0 ] - M2 ) / S2 );
+    Double_t g1( TMath::Exp( -0.5 * u1 * u1 ) );
+    Double_t g2( TMath::Exp( -0.5 * u2 * u2 ) );
+    Double_t value( N0 * K * ( g1 + N2 * g2 ) );
+    grad[ 0 ] = K * ( g1 + N2 * g2 );
+    grad[ 1 ] = N0 * K * g1 * u1 / S1;
+    grad[ 2 ] = N0 * K * g1 * u1 * u1 / S1 - value / sum;
+    grad[ 3 ] = N0 * K * g2 - value * S2 / sum;
+    grad[ 4 ] = N0 * K * N2 * g2 * u2 / S2;
+    grad[ 5 ] = N0 * K * N2 * g2 * u2 * u2 / S2 - value * N2 / sum;
   }
 
+}
+
+
+Double_t my::LowerCrystalBall::operator()( Double_t * x, Double_t * par )
+{
+
+  Double_t value;
+  Eval( 1, x, par, &value );
+
   return value;
 
 }
 
 
-Double_t my::LowerCrystalBall::operator()( Double_t * x, Double_t * par )
+void my::LowerCrystalBall::Eval( Int_t n, const Double_t * x, Double_t * par, Double_t * values )
+{
+
+  const CrystalBallTail tail( par[ 3 ], par[ 4 ] );
+
+  Double_t M( par[ 1 ] );
+  Double_t S( par[ 2 ] );
+  Double_t D( TMath::Sqrt( TMath::PiOver2() ) * ( 1. + tail.Erf_ ) );
+  Double_t N( par[ 0 ] / ( S * ( tail.C_ + D ) ) );
+
+  if ( ! ( N >= 0. && S > 0. ) ) {
+    for ( Int_t i = 0; i < n; ++i ) values[ i ] = -1.;
+    return;
+  }
+
+  Double_t NA( N * tail.A_ );
+  Double_t invS( 1. / S );
+
+  for ( Int_t i = 0; i < n; ++i ) {
+    Double_t E( ( x[ i ] - M ) * invS );
+    values[ i ] = E <= -par[ 3 ] ? NA * TMath::Power( ( tail.B_ - E ), -par[ 4 ] ) : N * TMath::Exp( -0.5 * E * E );
+  }
+
+}
+
+
+void my::LowerCrystalBall::Gradient( Double_t * x, Double_t * par, Double_t * grad )
 {
 
-  Double_t value( -1. );
+  for ( Int_t i = 0; i < NPar(); ++i ) grad[ i ] = 0.;
+
+  const CrystalBallTail tail( par[ 3 ], par[ 4 ] );
 
   Double_t M( par[ 1 ] );
   Double_t S( par[ 2 ] );
-  Double_t A( TMath::Power( par[ 4 ] / TMath::Abs( par[ 3 ] ), par[ 4 ] ) * TMath::Exp( -( TMath::Power( TMath::Abs( par[ 3 ] ), 2. ) / 2. ) ) );
-  Double_t B( par[ 4 ] / TMath::Abs( par[ 3 ] ) - TMath::Abs( par[ 3 ] ) );
-  Double_t C( ( par[ 4 ] / TMath::Abs( par[ 3 ] ) ) * ( 1. / ( par[ 4 ] - 1. ) ) * TMath::Exp( -( TMath::Power( TMath::Abs( par[ 3 ] ), 2. ) / 2. ) ) );
-  Double_t D( TMath::Sqrt( TMath::PiOver2() ) * ( 1. + TMath::Erf( TMath::Abs( par[ 3 ] ) / TMath::Sqrt( TMath::Pi() ) ) ) );
-  Double_t E( ( x[ 0 ] - M ) / S );
-  Double_t N( par[ 0 ] / ( par[ 2 ] * ( C + D ) ) );
+  Double_t D( TMath::Sqrt( TMath::PiOver2() ) * ( 1. + tail.Erf_ ) );
+  Double_t norm( tail.C_ + D );
+  Double_t N( par[ 0 ] / ( S * norm ) );
 
   if ( N >= 0. && S > 0. ) {
+    Double_t E( ( x[ 0 ] - M ) / S );
+    Double_t dLnNda( -( tail.dCda_ + TMath::Sqrt( TMath::PiOver2() ) * tail.dErfda_ ) / norm );
+    Double_t dLnNdn( -tail.dCdn_ / norm );
+    Double_t dLn[ 3 ] = { -E, 0., 0. };
+    Double_t shape;
     if ( E <= -par[ 3 ] ) {
-      value = N * A * TMath::Power( ( B - E ), -par[ 4 ] );
+      shape = tail.A_ * TMath::Power( ( tail.B_ - E ), -par[ 4 ] );
+      tailLogDerivatives( tail, par[ 4 ], -1., E, dLn );
     }
     else {
-      value = N * TMath::Exp( -0.5 * TMath::Power( E, 2. ) );
+      shape = TMath::Exp( -0.5 * E * E );
     }
+    Double_t value( N * shape );
+    coreGradient( E, S, norm, shape, value, dLn[ 0 ], grad );
+    grad[ 3 ] = tail.sign_ * value * ( dLnNda + dLn[ 1 ] );
+    grad[ 4 ] = value * ( dLnNdn + dLn[ 2 ] );
   }
 
+}
+
+
+Double_t my::UpperCrystalBall::operator()( Double_t * x, Double_t * par )
+{
+
+  Double_t value;
+  Eval( 1, x, par, &value );
+
   return value;
 
 }
 
 
-Double_t my::UpperCrystalBall::operator()( Double_t * x, Double_t * par )
+void my::UpperCrystalBall::Eval( Int_t n, const Double_t * x, Double_t * par, Double_t * values )
+{
+
+  const CrystalBallTail tail( par[ 3 ], par[ 4 ] );
+
+  Double_t M( par[ 1 ] );
+  Double_t S( par[ 2 ] );
+  Double_t D( TMath::Sqrt( TMath::PiOver2() ) * ( 1. + tail.Erf_ ) );
+  Double_t N( par[ 0 ] / ( S * ( tail.C_ + D ) ) );
+
+  if ( ! ( N >= 0. && S > 0. ) ) {
+    for ( Int_t i = 0; i < n; ++i ) values[ i ] = -1.;
+    return;
+  }
+
+  Double_t NA( N * tail.A_ );
+  Double_t invS( 1. / S );
+
+  for ( Int_t i = 0; i < n; ++i ) {
+    Double_t E( ( x[ i ] - M ) * invS );
+    values[ i ] = E >= par[ 3 ] ? NA * TMath::Power( ( tail.B_ + E ), -par[ 4 ] ) : N * TMath::Exp( -0.5 * E * E );
+  }
+
+}
+
+
+void my::UpperCrystalBall::Gradient( Double_t * x, Double_t * par, Double_t * grad )
 {
 
-  Double_t value( -1. );
+  for ( Int_t i = 0; i < NPar(); ++i ) grad[ i ] = 0.;
+
+  const CrystalBallTail tail( par[ 3 ], par[ 4 ] );
 
   Double_t M( par[ 1 ] );
   Double_t S( par[ 2 ] );
-  Double_t A( TMath::Power( par[ 4 ] / TMath::Abs( par[ 3 ] ), par[ 4 ] ) * TMath::Exp( -( TMath::Power( TMath::Abs( par[ 3 ] ), 2. ) / 2. ) ) );
-  Double_t B( par[ 4 ] / TMath::Abs( par[ 3 ] ) - TMath::Abs( par[ 3 ] ) );
-  Double_t C( ( par[ 4 ] / TMath::Abs( par[ 3 ] ) ) * ( 1. / ( par[ 4 ] - 1. ) ) * TMath::Exp( -( TMath::Power( TMath::Abs( par[ 3 ] ), 2. ) / 2. ) ) );
-  Double_t D( TMath::Sqrt( TMath::PiOver2() ) * ( 1. + TMath::Erf( TMath::Abs( par[ 3 ] ) / TMath::Sqrt( TMath::Pi() ) ) ) );
-  Double_t E( ( x[ 0 ] - M ) / S );
-  Double_t N( par[ 0 ] / ( par[ 2 ] * ( C + D ) ) );
+  Double_t D( TMath::Sqrt( TMath::PiOver2() ) * ( 1. + tail.Erf_ ) );
+  Double_t norm( tail.C_ + D );
+  Double_t N( par[ 0 ] / ( S * norm ) );
 
   if ( N >= 0. && S > 0. ) {
+    Double_t E( ( x[ 0 ] - M ) / S );
+    Double_t dLnNda( -( tail.dCda_ + TMath::Sqrt( TMath::PiOver2() ) * tail.dErfda_ ) / norm );
+    Double_t dLnNdn( -tail.dCdn_ / norm );
+    Double_t dLn[ 3 ] = { -E, 0., 0. };
+    Double_t shape;
     if ( E >= par[ 3 ] ) {
-      value = N * A * TMath::Power( ( B + E ), -par[ 4 ] );
+      shape = tail.A_ * TMath::Power( ( tail.B_ + E ), -par[ 4 ] );
+      tailLogDerivatives( tail, par[ 4 ], 1., E, dLn );
     }
     else {
-      value = N * TMath::Exp( -0.5 * TMath::Power( E, 2. ) );
+      shape = TMath::Exp( -0.5 * E * E );
     }
+    Double_t value( N * shape );
+    coreGradient( E, S, norm, shape, value, dLn[ 0 ], grad );
+    grad[ 3 ] = tail.sign_ * value * ( dLnNda + dLn[ 1 ] );
+    grad[ 4 ] = value * ( dLnNdn + dLn[ 2 ] );
   }
 
+}
+
+
+Double_t my::DoubleCrystalBall::operator()( Double_t * x, Double_t * par )
+{
+
+  Double_t value;
+  Eval( 1, x, par, &value );
+
   return value;
 
 }
 
 
-Double_t my::DoubleCrystalBall::operator()( Double_t * x, Double_t * par )
+void my::DoubleCrystalBall::Eval( Int_t n, const Double_t * x, Double_t * par, Double_t * values )
 {
 
-  Double_t value( -1. );
+  const CrystalBallTail lowerTail( par[ 3 ], par[ 4 ] );
+  const CrystalBallTail upperTail( par[ 5 ], par[ 6 ] );
 
   Double_t M( par[ 1 ] );
   Double_t S( par[ 2 ] );
-  Double_t A1( TMath::Power( par[ 4 ] / TMath::Abs( par[ 3 ] ), par[ 4 ] ) * TMath::Exp( -( TMath::Power( TMath::Abs( par[ 3 ] ), 2. ) / 2. ) ) );
-  Double_t B1( par[ 4 ] / TMath::Abs( par[ 3 ] ) - TMath::Abs( par[ 3 ] ) );
-  Double_t C1( ( par[ 4 ] / TMath::Abs( par[ 3 ] ) ) * ( 1. / ( par[ 4 ] - 1. ) ) * TMath::Exp( -( TMath::Power( TMath::Abs( par[ 3 ] ), 2. ) / 2. ) ) );
-  Double_t A2( TMath::Power( par[ 6 ] / TMath::Abs( par[ 5 ] ), par[ 6 ] ) * TMath::Exp( -( TMath::Power( TMath::Abs( par[ 5 ] ), 2. ) / 2. ) ) );
-  Double_t B2( par[ 6 ] / TMath::Abs( par[ 5 ] ) - TMath::Abs( par[ 5 ] ) );
-  Double_t C2( ( par[ 6 ] / TMath::Abs( par[ 5 ] ) ) * ( 1. / ( par[ 6 ] - 1. ) ) * TMath::Exp( -( TMath::Power( TMath::Abs( par[ 5 ] ), 2. ) / 2. ) ) );
-  Double_t D( TMath::Sqrt( TMath::PiOver2() ) * ( TMath::Erf( TMath::Abs( par[ 3 ] ) / TMath::Sqrt( TMath::Pi() ) ) + TMath::Erf( TMath::Abs( par[ 5 ] ) / TMath::Sqrt( TMath::Pi() ) ) ) );
-  Double_t E( ( x[ 0 ] - M ) / S );
-  Double_t N( par[ 0 ] / ( par[ 2 ] * ( C1 + C2 + D ) ) ); // FIXME: Is this the norm?
+  Double_t D( TMath::Sqrt( TMath::PiOver2() ) * ( lowerTail.Erf_ + upperTail.Erf_ ) );
+  Double_t N( par[ 0 ] / ( S * ( lowerTail.C_ + upperTail.C_ + D ) ) ); // FIXME: Is this the norm?
 
-  if ( N >= 0. && S > 0. ) {
+  if ( ! ( N >= 0. && S > 0. ) ) {
+    for ( Int_t i = 0; i < n; ++i ) values[ i ] = -1.;
+    return;
+  }
+
+  Double_t NA1( N * lowerTail.A_ );
+  Double_t NA2( N * upperTail.A_ );
+  Double_t invS( 1. / S );
+
+  for ( Int_t i = 0; i < n; ++i ) {
+    Double_t E( ( x[ i ] - M ) * invS );
     if ( E <= -par[ 3 ] ) {
-      value = N * A1 * TMath::Power( ( B1 - E ), -par[ 4 ] );
+      values[ i ] = NA1 * TMath::Power( ( lowerTail.B_ - E ), -par[ 4 ] );
     }
     else if ( E >= par[ 5 ] ) {
-      value = N * A2 * TMath::Power( ( B2 + E ), -par[ 6 ] );
+      values[ i ] = NA2 * TMath::Power( ( upperTail.B_ + E ), -par[ 6 ] );
     }
     else {
-      value = N * TMath::Exp( -0.5 * TMath::Power( E, 2. ) );
+      values[ i ] = N * TMath::Exp( -0.5 * E * E );
     }
   }
 
-  return value;
+}
+
+
+void my::DoubleCrystalBall::Gradient( Double_t * x, Double_t * par, Double_t * grad )
+{
+
+  for ( Int_t i = 0; i < NPar(); ++i ) grad[ i ] = 0.;
+
+  const CrystalBallTail lowerTail( par[ 3 ], par[ 4 ] );
+  const CrystalBallTail upperTail( par[ 5 ], par[ 6 ] );
+
+  Double_t M( par[ 1 ] );
+  Double_t S( par[ 2 ] );
+  Double_t D( TMath::Sqrt( TMath::PiOver2() ) * ( lowerTail.Erf_ + upperTail.Erf_ ) );
+  Double_t norm( lowerTail.C_ + upperTail.C_ + D );
+  Double_t N( par[ 0 ] / ( S * norm ) );
+
+  if ( N >= 0. && S > 0. ) {
+    Double_t E( ( x[ 0 ] - M ) / S );
+    Double_t dLnNda1( -( lowerTail.dCda_ + TMath::Sqrt( TMath::PiOver2() ) * lowerTail.dErfda_ ) / norm );
+    Double_t dLnNdn1( -lowerTail.dCdn_ / norm );
+    Double_t dLnNda2( -( upperTail.dCda_ + TMath::Sqrt( TMath::PiOver2() ) * upperTail.dErfda_ ) / norm );
+    Double_t dLnNdn2( -upperTail.dCdn_ / norm );
+    Double_t dLn1[ 3 ] = { -E, 0., 0. };
+    Double_t dLn2[ 3 ] = { -E, 0., 0. };
+    Double_t shape;
+    if ( E <= -par[ 3 ] ) {
+      shape = lowerTail.A_ * TMath::Power( ( lowerTail.B_ - E ), -par[ 4 ] );
+      tailLogDerivatives( lowerTail, par[ 4 ], -1., E, dLn1 );
+      dLn2[ 0 ] = dLn1[ 0 ];
+    }
+    else if ( E >= par[ 5 ] ) {
+      shape = upperTail.A_ * TMath::Power( ( upperTail.B_ + E ), -par[ 6 ] );
+      tailLogDerivatives( upperTail, par[ 6 ], 1., E, dLn2 );
+      dLn1[ 0 ] = dLn2[ 0 ];
+    }
+    else {
+      shape = TMath::Exp( -0.5 * E * E );
+    }
+    Double_t value( N * shape );
+    coreGradient( E, S, norm, shape, value, dLn1[ 0 ], grad );
+    grad[ 3 ] = lowerTail.sign_ * value * ( dLnNda1 + dLn1[ 1 ] );
+    grad[ 4 ] = value * ( dLnNdn1 + dLn1[ 2 ] );
+    grad[ 5 ] = upperTail.sign_ * value * ( dLnNda2 + dLn2[ 1 ] );
+    grad[ 6 ] = value * ( dLnNdn2 + dLn2[ 2 ] );
+  }
 
 }
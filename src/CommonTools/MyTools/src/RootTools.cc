@@ -1,5 +1,10 @@
 #include "CommonTools/MyTools/interface/RootTools.h"
 
+#include <algorithm>
+
+#include "TBranch.h"
+#include "TLeaf.h"
+
 
 void my::setPlotEnvironment( TStyle * style )
 {
@@ -23,3 +28,72 @@ void my::setPlotEnvironment( TStyle * style )
   style->SetMarkerStyle( kFullDotSmall );
 
 }
+
+
+bool my::readColumn( TTree * tree, const std::string & name, std::vector< Double_t > & column )
+{
+
+  column.clear();
+  TBranch * branch( tree->GetBranch( name.c_str() ) );
+  if ( branch == 0 ) return false;
+  const Long64_t nEntries( branch->GetEntries() );
+  const std::string className( branch->GetClassName() );
+  // Address set by the caller, restored after reading
+  void * address( branch->GetAddress() );
+
+  if ( className == "vector<double>" ) {
+    std::vector< double > * values( 0 );
+    tree->SetBranchAddress( name.c_str(), &values, &branch );
+    for ( Long64_t iEntry = 0; iEntry < nEntries; ++iEntry ) {
+      branch->GetEntry( iEntry );
+      column.insert( column.end(), values->begin(), values->end() );
+    }
+    tree->ResetBranchAddress( branch );
+    delete values;
+    if ( address != 0 ) tree->SetBranchAddress( name.c_str(), address );
+    return true;
+  }
+  if ( className == "vector<int>" ) {
+    std::vector< int > * values( 0 );
+    tree->SetBranchAddress( name.c_str(), &values, &branch );
+    for ( Long64_t iEntry = 0; iEntry < nEntries; ++iEntry ) {
+      branch->GetEntry( iEntry );
+      column.insert( column.end(), values->begin(), values->end() );
+    }
+    tree->ResetBranchAddress( branch );
+    delete values;
+    if ( address != 0 ) tree->SetBranchAddress( name.c_str(), address );
+    return true;
+  }
+  if ( ! className.empty() || branch->GetNleaves() != 1 ) return false;
+
+  // Scalar branch
+  TLeaf * leaf( static_cast< TLeaf * >( branch->GetListOfLeaves()->At( 0 ) ) );
+  const std::string typeName( leaf->GetTypeName() );
+  if ( typeName != "Double_t" && typeName != "Float_t" && typeName != "Int_t" ) return false;
+  // The address is kept, but the value of the caller's variable there is overwritten while reading
+  std::vector< char > value;
+  if ( address != 0 ) value.assign( ( char * )address, ( char * )address + leaf->GetLenType() * leaf->GetLen() );
+  column.reserve( nEntries );
+  for ( Long64_t iEntry = 0; iEntry < nEntries; ++iEntry ) {
+    branch->GetEntry( iEntry );
+    column.push_back( leaf->GetValue() );
+  }
+  if ( ! value.empty() ) std::copy( value.begin(), value.end(), ( char * )address );
+  return true;
+
+}
+
+
+bool my::readColumns( TTree * tree, const std::vector< std::string > & names, std::vector< std::vector< Double_t > > & columns )
+{
+
+  columns.clear();
+  columns.resize( names.size() );
+  for ( unsigned iName = 0; iName < names.size(); ++iName ) {
+    if ( ! readColumn( tree, names.at( iName ), columns.at( iName ) ) ) return false;
+    if ( columns.at( iName ).size() != columns.front().size() ) return false;
+  }
+  return true;
+
+}
@@ -0,0 +1,92 @@
+#ifndef SiPixelCommon_SiPixelHistogramBuffer_h
+#define SiPixelCommon_SiPixelHistogramBuffer_h
+// -*- C++ -*-
+//
+// Package:     SiPixelCommon
+// Class  :     SiPixelHistogramBuffer
+//
+/**
+
+ Description: Fixed-binning fill buffer in front of a 1D MonitorElement
+
+ Usage:
+    Attach to a booked 1D ME with attach(), call fill() on the per-event
+    hot path and flush() at the luminosity block boundary (and before the
+    DQM store is saved). fill() only increments a plain counter array;
+    the ROOT histogram is touched once per non-empty bin and flush.
+
+*/
+
+#include "DQMServices/Core/interface/MonitorElement.h"
+
+#include "TH1.h"
+#include "TArrayD.h"
+
+#include <vector>
+
+class SiPixelHistogramBuffer {
+
+ public:
+
+  SiPixelHistogramBuffer() : me_(0), nBins_(0), xMin_(0.), xMax_(0.), nEntries_(0) {}
+
+  /// take over the binning of a booked (fixed-binning) 1D ME
+  void attach(MonitorElement* me) {
+    me_ = me;
+    nBins_ = 0; xMin_ = 0.; xMax_ = 0.; nEntries_ = 0;
+    sumW_.clear(); sumW2_.clear();
+    if ( !me_ || !me_->getTH1() ) return;
+    const TAxis* axis = me_->getTH1()->GetXaxis();
+    nBins_ = axis->GetNbins();
+    xMin_  = axis->GetXmin();
+    xMax_  = axis->GetXmax();
+    // including under- and overflow
+    sumW_.assign( nBins_ + 2, 0. );
+    sumW2_.assign( nBins_ + 2, 0. );
+  }
+
+  bool isAttached() const { return me_ != 0; }
+
+  /// accumulate one entry; same bin assignment as TAxis::FindFixBin()
+  void fill(double x, double w = 1.) {
+    if ( !me_ ) return;
+    int bin;
+    if      ( x <  xMin_ ) bin = 0;
+    else if ( x >= xMax_ ) bin = nBins_ + 1;
+    else                   bin = 1 + int( nBins_ * ( x - xMin_ ) / ( xMax_ - xMin_ ) );
+    sumW_[bin]  += w;
+    sumW2_[bin] += w * w;
+    ++nEntries_;
+  }
+
+  /// add the accumulated contents to the ME and clear the buffer
+  void flush() {
+    if ( !me_ || nEntries_ == 0 ) return;
+    TH1* histo = me_->getTH1();
+    const bool hasSumw2( histo->GetSumw2N() > 0 );
+    for ( int bin = 0; bin < nBins_ + 2; ++bin ) {
+      if ( sumW2_[bin] == 0. ) continue;
+      histo->AddBinContent( bin, sumW_[bin] );
+      if ( hasSumw2 ) histo->GetSumw2()->fArray[bin] += sumW2_[bin];
+      sumW_[bin]  = 0.;
+      sumW2_[bin] = 0.;
+    }
+    histo->SetEntries( histo->GetEntries() + nEntries_ );
+    nEntries_ = 0;
+    // the TH1 was modified behind the ME's back: flag it for (online) DQM
+    me_->update();
+  }
+
+ private:
+
+  MonitorElement*     me_;
+  int                 nBins_;
+  double              xMin_;
+  double              xMax_;
+  std::vector<double> sumW_;
+  std::vector<double> sumW2_;
+  unsigned            nEntries_;
+
+};
+
+#endif
@@ -31,6 +31,7 @@
 #include "DQMServices/Core/interface/DQMStore.h"
 
 #include "DQM/SiPixelMonitorCluster/interface/SiPixelClusterModule.h"
+#include "DQM/SiPixelCommon/interface/SiPixelHistogramBuffer.h"
 
 #include "DataFormats/Common/interface/DetSetVectorNew.h"
 #include "DataFormats/SiPixelDigi/interface/PixelDigi.h"
@@ -72,8 +73,10 @@
        virtual void beginJob() ;
        virtual void endJob() ;
        virtual void beginRun(const edm::Run&, edm::EventSetup const&) ;
+       virtual void endLuminosityBlock(const edm::LuminosityBlock&, edm::EventSetup const&) ;
 
        virtual void buildStructure(edm::EventSetup const&);
+       virtual void buildModuleTable();
        virtual void bookMEs();
 
     private:
@@ -85,6 +88,9 @@
        int eventNo;
        DQMStore* theDMBE;
        std::map<uint32_t,SiPixelClusterModule*> thePixelStructure;
+       // flat copy of thePixelStructure in DetId order, walked against the sorted input
+       std::vector<uint32_t> theModuleIds;
+       std::vector<SiPixelClusterModule*> theModules;
        bool modOn;
        bool twoDimOn;
        bool reducedSet;
@@ -98,6 +104,8 @@
        int nLumiSecs;
        int nBigEvents;
        MonitorElement* bigFpixClusterEventRate;
+       // per-event fills, flushed into the ME at the end of each lumi section
+       SiPixelHistogramBuffer bigFpixClusterEventRateBuffer_;
        int bigEventSize;
 
   MonitorElement* meClPosLayer1;
@@ -103,6 +103,7 @@ void SiPixelClusterSource::beginRun(const edm::Run& r, const edm::EventSetup& iS
     nBigEvents = 0;
     // Build map
     buildStructure(iSetup);
+    buildModuleTable();
     // Book Monitoring Elements
     bookMEs();
     // Book occupancy maps in global coordinates for all clusters:
@@ -124,7 +125,13 @@ void SiPixelClusterSource::beginRun(const edm::Run& r, const edm::EventSetup& iS
 }
 
 
+void SiPixelClusterSource::endLuminosityBlock(const edm::LuminosityBlock& lb, const edm::EventSetup& iSetup){
+  bigFpixClusterEventRateBuffer_.flush();
+}
+
+
 void SiPixelClusterSource::endJob(void){
+  bigFpixClusterEventRateBuffer_.flush();
   if(saveFile){
     LogInfo ("PixelDQM") << " SiPixelClusterSource::endJob - Saving Root File " << std::endl;
     std::string outputFile = conf_.getParameter<std::string>("outputFile");
@@ -174,10 +181,17 @@ void SiPixelClusterSource::analyze(const edm::Event& iEvent, const edm::EventSet
   int nEventFpixClusters = 0;
 
 
-  std::map<uint32_t,SiPixelClusterModule*>::iterator struct_iter;
-  for (struct_iter = thePixelStructure.begin() ; struct_iter != thePixelStructure.end() ; struct_iter++) {
+  // Both the module table and the DetSetVector are sorted by DetId, so a
+  // single merge-walk finds the slot of every module with clusters; modules
+  // without clusters are not visited at all.
+  std::vector<uint32_t>::size_type iModule = 0;
+  const std::vector<uint32_t>::size_type nModules = theModuleIds.size();
+  for (edmNew::DetSetVector<SiPixelCluster>::const_iterator iDetSet = input->begin(); iDetSet != input->end() && iModule != nModules; ++iDetSet) {
+    uint32_t detId = (*iDetSet).id();
+    while(iModule != nModules && theModuleIds[iModule] < detId) iModule++;
+    if(iModule == nModules || theModuleIds[iModule] != detId) continue;
 
-    int numberOfFpixClusters = (*struct_iter).second->fill(*input, tracker,  modOn,
+    int numberOfFpixClusters = theModules[iModule]->fill(*input, tracker,  modOn,
                                                            ladOn, layOn, phiOn,
                                                            bladeOn, diskOn, ringOn,
 							   twoDimOn, reducedSet, smileyOn);
@@ -190,10 +204,7 @@ void SiPixelClusterSource::analyze(const edm::Event& iEvent, const edm::EventSet
 //  if(nLumiSecs%5==0){
 
   if(nEventFpixClusters>bigEventSize){
-    MonitorElement* me = theDMBE->get("Pixel/bigFpixClusterEventRate");
-    if(me){
-      if ( triggerFlag_->accept( iEvent, iSetup ) ) me->Fill(lumiSection,1./23.);
-    }
+    if ( triggerFlag_->accept( iEvent, iSetup ) ) bigFpixClusterEventRateBuffer_.fill(lumiSection,1./23.);
   }
   //std::cout<<"nEventFpixClusters: "<<nEventFpixClusters<<" , nLumiSecs: "<<nLumiSecs<<" , nBigEvents: "<<nBigEvents<<std::endl;
 
@@ -262,6 +273,23 @@ void SiPixelClusterSource::buildStructure(const edm::EventSetup& iSetup){
   }
   LogInfo ("PixelDQM") << " *** Pixel Structure Size " << thePixelStructure.size() << endl;
 }
+//------------------------------------------------------------------
+// Flatten the structure into a DetId-ordered table
+//------------------------------------------------------------------
+void SiPixelClusterSource::buildModuleTable(){
+
+  theModuleIds.clear();
+  theModules.clear();
+  theModuleIds.reserve(thePixelStructure.size());
+  theModules.reserve(thePixelStructure.size());
+
+  std::map<uint32_t,SiPixelClusterModule*>::const_iterator struct_iter;
+  for(struct_iter = thePixelStructure.begin(); struct_iter != thePixelStructure.end(); struct_iter++){
+    theModuleIds.push_back((*struct_iter).first);
+    theModules.push_back((*struct_iter).second);
+  }
+}
+
 //------------------------------------------------------------------
 // Book MEs
 //------------------------------------------------------------------
@@ -272,6 +300,7 @@ void SiPixelClusterSource::bookMEs(){
   theDMBE->setCurrentFolder("Pixel");
   char title[80]; sprintf(title, "Rate of events with >%i FPIX clusters;LumiSection;Rate of large FPIX events per LS [Hz]",bigEventSize);
   bigFpixClusterEventRate = theDMBE->book1D("bigFpixClusterEventRate",title,5000,0.,5000.);
+  bigFpixClusterEventRateBuffer_.attach(bigFpixClusterEventRate);
 
 
   std::map<uint32_t,SiPixelClusterModule*>::iterator struct_iter;
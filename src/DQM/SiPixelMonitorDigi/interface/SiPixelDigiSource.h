@@ -29,6 +29,7 @@
 #include "DQMServices/Core/interface/DQMStore.h"
 
 #include "DQM/SiPixelMonitorDigi/interface/SiPixelDigiModule.h"
+#include "DQM/SiPixelCommon/interface/SiPixelHistogramBuffer.h"
 
 #include "DataFormats/Common/interface/DetSetVector.h"
 #include "DataFormats/SiPixelDigi/interface/PixelDigi.h"
@@ -59,8 +60,10 @@
        virtual void beginJob() ;
        virtual void endJob() ;
        virtual void beginRun(const edm::Run&, edm::EventSetup const&) ;
+       virtual void endLuminosityBlock(const edm::LuminosityBlock&, edm::EventSetup const&) ;
 
        virtual void buildStructure(edm::EventSetup const&);
+       virtual void buildModuleTable();
        virtual void bookMEs();
 
     private:
@@ -84,6 +87,10 @@
        int nLumiSecs;
        DQMStore* theDMBE;
        std::map<uint32_t,SiPixelDigiModule*> thePixelStructure;
+       // flat copy of thePixelStructure in DetId order, walked against the sorted input
+       std::vector<uint32_t> theModuleIds;
+       std::vector<SiPixelDigiModule*> theModules;
+       std::vector<int> theModuleFeds;
 
        int nBigEvents;
        int nBPIXDigis;
@@ -95,6 +102,10 @@
        MonitorElement* avgfedDigiOccvsLumi;
        MonitorElement* meNDigisCOMBBarrel_;
        MonitorElement* meNDigisCOMBEndcap_;
+       // per-event fills, flushed into the MEs at the end of each lumi section
+       SiPixelHistogramBuffer bigEventRateBuffer_;
+       SiPixelHistogramBuffer pixEvtsPerBXBuffer_;
+       SiPixelHistogramBuffer pixEventRateBuffer_;
 
        int bigEventSize;
 
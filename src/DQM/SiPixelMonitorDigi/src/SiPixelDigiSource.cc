@@ -113,6 +113,7 @@ void SiPixelDigiSource::beginRun(const edm::Run& r, const edm::EventSetup& iSetu
 
     // Build map
     buildStructure(iSetup);
+    buildModuleTable();
     // Book Monitoring Elements
     bookMEs();
     firstRun = false;
@@ -122,8 +123,20 @@ void SiPixelDigiSource::beginRun(const edm::Run& r, const edm::EventSetup& iSetu
 }
 
 
+void SiPixelDigiSource::endLuminosityBlock(const edm::LuminosityBlock& lb, const edm::EventSetup& iSetup){
+
+  bigEventRateBuffer_.flush();
+  pixEvtsPerBXBuffer_.flush();
+  pixEventRateBuffer_.flush();
+}
+
+
 void SiPixelDigiSource::endJob(void){
 
+  bigEventRateBuffer_.flush();
+  pixEvtsPerBXBuffer_.flush();
+  pixEventRateBuffer_.flush();
+
   if(saveFile) {
     LogInfo ("PixelDQM") << " SiPixelDigiSource::endJob - Saving Root File " << std::endl;
     std::string outputFile = conf_.getParameter<std::string>("outputFile");
@@ -162,43 +175,29 @@ void SiPixelDigiSource::analyze(const edm::Event& iEvent, const edm::EventSetup&
   int nEventDigis = 0; int nActiveModules = 0;
   //int nEventBPIXDigis = 0; int nEventFPIXDigis = 0;
 
-  std::map<uint32_t,SiPixelDigiModule*>::iterator struct_iter;
-  for (struct_iter = thePixelStructure.begin() ; struct_iter != thePixelStructure.end() ; struct_iter++) {
-    int numberOfDigis = (*struct_iter).second->fill(*input, modOn,
+  // Both the module table and the DetSetVector are sorted by DetId, so a
+  // single merge-walk finds the slot of every module with digis; modules
+  // without digis are not visited at all.
+  std::vector<uint32_t>::size_type iModule = 0;
+  const std::vector<uint32_t>::size_type nModules = theModuleIds.size();
+  for (edm::DetSetVector<PixelDigi>::const_iterator iDetSet = input->begin(); iDetSet != input->end() && iModule != nModules; iDetSet++) {
+    uint32_t detId = iDetSet->id;
+    while(iModule != nModules && theModuleIds[iModule] < detId) iModule++;
+    if(iModule == nModules || theModuleIds[iModule] != detId) continue;
+    int numberOfDigis = theModules[iModule]->fill(*input, modOn,
 				ladOn, layOn, phiOn,
 				bladeOn, diskOn, ringOn,
 				twoDimOn, reducedSet, twoDimModOn, twoDimOnlyLayDisk);
     if(numberOfDigis>0){
       nEventDigis = nEventDigis + numberOfDigis;
-      if(numberOfDigis>0) nActiveModules++;
-      if((*struct_iter).first >= 302055684 && (*struct_iter).first <= 302197792 ){
-        //cout<<"AAbpix: "<<numberOfDigis<<" + "<<nBPIXDigis<<" = ";
+      nActiveModules++;
+      if(detId >= 302055684 && detId <= 302197792 ){
         nBPIXDigis = nBPIXDigis + numberOfDigis;
-	//cout<<nBPIXDigis<<endl;
-        for(int i=0; i!=768; i++){
-          //cout<<"\t\t\t bpix: "<<i<<" , "<<(*struct_iter).first<<" , "<<I_detId[i]<<endl;
-          if((*struct_iter).first == I_detId[i]){
-	    //if(I_fedId[i]>=32&&I_fedId[i]<=39) std::cout<<"Attention: a BPIX module matched to an FPIX FED!"<<std::endl;
-	    nDigisPerFed[I_fedId[i]]=nDigisPerFed[I_fedId[i]]+numberOfDigis;
-	    //cout<<"BPIX: "<<i<<" , "<<I_fedId[i]<<" , "<<numberOfDigis<<" , "<<nDigisPerFed[I_fedId[i]]<<endl;
-	    i=767;
-	  }
-        }
-      }else if((*struct_iter).first >= 343999748 && (*struct_iter).first <= 352477708 ){
-        //cout<<"AAfpix: "<<numberOfDigis<<" + "<<nFPIXDigis<<" = ";
+      }else if(detId >= 343999748 && detId <= 352477708 ){
         nFPIXDigis = nFPIXDigis + numberOfDigis;
-	//cout<<nFPIXDigis<<endl;
-        for(int i=768; i!=1440; i++){
-          //cout<<"\t\t\t fpix: "<<i<<" , "<<(*struct_iter).first<<" , "<<I_detId[i]<<endl;
-          if((*struct_iter).first == I_detId[i]){
-	    //if(I_fedId[i]<32||I_fedId[i]>39) std::cout<<"Attention: an FPIX module matched to a BPIX FED!"<<std::endl;
-	    nDigisPerFed[I_fedId[i]]=nDigisPerFed[I_fedId[i]]+numberOfDigis;
-	    //cout<<"FPIX: "<<i<<" , "<<I_fedId[i]<<" , "<<numberOfDigis<<" , "<<nDigisPerFed[I_fedId[i]]<<endl;
-	    i=1439;
-	  }
-        }
       }
-      //cout<<"numberOfDigis: "<<numberOfDigis<<" , nBPIXDigis: "<<nBPIXDigis<<" , nFPIXDigis: "<<nFPIXDigis<<endl;
+      int fedId = theModuleFeds[iModule];
+      if(fedId>=0) nDigisPerFed[fedId]=nDigisPerFed[fedId]+numberOfDigis;
     }
   }
 
@@ -210,17 +209,14 @@ void SiPixelDigiSource::analyze(const edm::Event& iEvent, const edm::EventSetup&
 
   // Rate of events with >N digis:
   if(nEventDigis>bigEventSize){
-    me = theDMBE->get("Pixel/bigEventRate");
-    if(me && eventFlag) me->Fill(lumiSection,1./23.);
+    if(eventFlag) bigEventRateBuffer_.fill(lumiSection,1./23.);
   }
   //std::cout<<"nEventDigis: "<<nEventDigis<<" , nLumiSecs: "<<nLumiSecs<<" , nBigEvents: "<<nBigEvents<<std::endl;
 
   // Rate of pixel events and total number of pixel events per BX:
   if(nActiveModules>=4){
-    me = theDMBE->get("Pixel/pixEvtsPerBX");
-    if(me && eventFlag) me->Fill(float(bx));
-    me1 = theDMBE->get("Pixel/pixEventRate");
-    if(me1 && eventFlag) me1->Fill(lumiSection, 1./23.);
+    if(eventFlag) pixEvtsPerBXBuffer_.fill(float(bx));
+    if(eventFlag) pixEventRateBuffer_.fill(lumiSection, 1./23.);
   }
 
   // Actual digi occupancy in a FEDs compared to average digi occupancy per FED
@@ -317,6 +313,41 @@ void SiPixelDigiSource::buildStructure(const edm::EventSetup& iSetup){
   }
   LogInfo ("PixelDQM") << " *** Pixel Structure Size " << thePixelStructure.size() << endl;
 }
+//------------------------------------------------------------------
+// Flatten the structure into a DetId-ordered table with FED numbers
+//------------------------------------------------------------------
+void SiPixelDigiSource::buildModuleTable(){
+
+  theModuleIds.clear();
+  theModules.clear();
+  theModuleFeds.clear();
+  theModuleIds.reserve(thePixelStructure.size());
+  theModules.reserve(thePixelStructure.size());
+  theModuleFeds.reserve(thePixelStructure.size());
+
+  std::map<uint32_t,SiPixelDigiModule*>::const_iterator struct_iter;
+  for(struct_iter = thePixelStructure.begin(); struct_iter != thePixelStructure.end(); struct_iter++){
+    uint32_t id = (*struct_iter).first;
+    // BPIX modules are listed first in detId.dat, FPIX modules after entry 768
+    int iFirst = 0; int iLast = 0;
+    if(id >= 302055684 && id <= 302197792 ){
+      iFirst = 0; iLast = 768;
+    }else if(id >= 343999748 && id <= 352477708 ){
+      iFirst = 768; iLast = 1440;
+    }
+    int fedId = -1;
+    for(int i=iFirst; i!=iLast; i++){
+      if(id == I_detId[i]){
+        fedId = I_fedId[i];
+        break;
+      }
+    }
+    theModuleIds.push_back(id);
+    theModules.push_back((*struct_iter).second);
+    theModuleFeds.push_back(fedId);
+  }
+}
+
 //------------------------------------------------------------------
 // Book MEs
 //------------------------------------------------------------------
@@ -331,6 +362,9 @@ void SiPixelDigiSource::bookMEs(){
   pixEvtsPerBX = theDMBE->book1D("pixEvtsPerBX",title1,3565,0.,3565.);
   char title2[80]; sprintf(title2, "Rate of Pixel events;LumiSection;Rate [Hz]");
   pixEventRate = theDMBE->book1D("pixEventRate",title2,5000,0.,5000.);
+  bigEventRateBuffer_.attach(bigEventRate);
+  pixEvtsPerBXBuffer_.attach(pixEvtsPerBX);
+  pixEventRateBuffer_.attach(pixEventRate);
   char title3[80]; sprintf(title3, "Average digi occupancy per FED;FED;NDigis/<NDigis>");
   averageDigiOccupancy = theDMBE->book1D("averageDigiOccupancy",title3,40,-0.5,39.5);
   if(modOn){
@@ -22,9 +22,95 @@
 #include "DQM/SiStripMonitorTrack/interface/SiStripMonitorTrack.h"
 
 #include "DQM/SiStripCommon/interface/SiStripHistoId.h"
+#include "FWCore/ServiceRegistry/interface/ServiceRegistry.h"
 #include "TMath.h"
+#include "tbb/parallel_for.h"
+#include "tbb/blocked_range.h"
+#include <algorithm>
 #include <iostream> // DEBUG
 
+namespace {
+
+  /// Quantities of an accepted off-track cluster, as filled by SiStripMonitorTrack::fillMEs()
+  struct OffTrackCluster {
+    size_t   detSet;
+    uint32_t detId;
+    float    StoN;
+    float    noise;
+    uint16_t charge;
+    uint16_t width;
+    float    position;
+  };
+
+  /// Cluster quality cut of SiStripMonitorTrack::clusterInfos()
+  struct ClusterQualityCut {
+    bool   on;
+    double minStoN;
+    double maxStoN;
+    double minWidth;
+    double maxWidth;
+  };
+
+  /// Collects the accepted off-track clusters of sub-detector partitions into private buffers
+  /// Partition 'p' holds the DetSets [ partitions[ p ], partitions[ p + 1 ] ).
+  class OffTrackClusterBody {
+
+      const std::vector< edmNew::DetSet<SiStripCluster> > & detSets_;
+      const std::vector< size_t > & partitions_;
+      const std::vector< bool > & excluded_;
+      const std::vector< const SiStripCluster* > & onTrack_;
+      const edm::EventSetup & es_;
+      ClusterQualityCut cut_;
+      edm::ServiceToken token_;
+      std::vector< std::vector< OffTrackCluster > > * clusters_;
+
+    public:
+
+      OffTrackClusterBody( const std::vector< edmNew::DetSet<SiStripCluster> > & detSets, const std::vector< size_t > & partitions, const std::vector< bool > & excluded, const std::vector< const SiStripCluster* > & onTrack, const edm::EventSetup & es, const ClusterQualityCut & cut, std::vector< std::vector< OffTrackCluster > > * clusters )
+      : detSets_( detSets )
+      , partitions_( partitions )
+      , excluded_( excluded )
+      , onTrack_( onTrack )
+      , es_( es )
+      , cut_( cut )
+      , token_( edm::ServiceRegistry::instance().presentToken() )
+      , clusters_( clusters )
+      {}
+
+      void operator()( const tbb::blocked_range< size_t > & range ) const
+      {
+        // the worker threads have no services of their own
+        edm::ServiceRegistry::Operate operate( token_ );
+        for ( size_t p = range.begin(); p != range.end(); ++p ) {
+          std::vector< OffTrackCluster > & clusters( clusters_->at( p ) );
+          for ( size_t d = partitions_.at( p ); d != partitions_.at( p + 1 ); ++d ) {
+            if ( excluded_[ d ] ) continue;
+            for ( edmNew::DetSet<SiStripCluster>::const_iterator ClusIter = detSets_[ d ].begin(); ClusIter != detSets_[ d ].end(); ++ClusIter ) {
+              if ( std::find( onTrack_.begin(), onTrack_.end(), &*ClusIter ) != onTrack_.end() ) continue;
+              SiStripClusterInfo info( *ClusIter, es_ );
+              if ( cut_.on &&
+                   ( info.signalOverNoise() < cut_.minStoN ||
+                     info.signalOverNoise() > cut_.maxStoN ||
+                     info.width() < cut_.minWidth ||
+                     info.width() > cut_.maxWidth ) ) continue;
+              OffTrackCluster cluster;
+              cluster.detSet   = d;
+              cluster.detId    = info.detId();
+              cluster.StoN     = info.signalOverNoise();
+              cluster.noise    = info.noiseRescaledByGain();
+              cluster.charge   = info.charge();
+              cluster.width    = info.width();
+              cluster.position = info.baryStrip();
+              clusters.push_back( cluster );
+            }
+          }
+        }
+      }
+
+  };
+
+}
+
 SiStripMonitorTrack::SiStripMonitorTrack(const edm::ParameterSet& conf):
   dbe(edm::Service<DQMStore>().operator->()),
   conf_(conf),
@@ -579,6 +665,80 @@ void SiStripMonitorTrack::AllClusters(const edm::Event& ev, const edm::EventSetu
     edm::LogError("SiStripMonitorTrack")<< "ClusterCollection is not valid!!" << std::endl;
     return;
   }
+  // Opt-in: the sub-detector partitions (TIB, TID, TOB, TEC) collect their off-track clusters
+  // concurrently into private buffers, which are filled into the MEs afterwards in input order.
+  // No ME is touched concurrently, so the results are identical to the serial loop below.
+  if (conf_.getUntrackedParameter<bool>("ParallelSubDet_On",false)) {
+    SiStripFolderOrganizer folder_organizer;
+    SiStripHistoId hidmanager;
+    std::vector< edmNew::DetSet<SiStripCluster> > detSets;
+    std::vector< bool > excluded;
+    std::vector< size_t > partitions;
+    std::vector< std::map<std::string, LayerMEs>::iterator > layers;
+    std::vector< std::map<std::string, SubDetMEs>::iterator > subDets;
+    int lastSubDet = -1;
+    // the DetSets are unpacked here, since on-demand collections are not thread-safe
+    for ( edmNew::DetSetVector<SiStripCluster>::const_iterator DSViter=siStripClusterHandle->begin(); DSViter!=siStripClusterHandle->end();DSViter++){
+      uint32_t detid=DSViter->id();
+      int subDet = DetId(detid).subdetId();
+      if (subDet != lastSubDet) {
+        partitions.push_back(detSets.size());
+        lastSubDet = subDet;
+      }
+      detSets.push_back(*DSViter);
+      excluded.push_back(find(ModulesToBeExcluded_.begin(),ModulesToBeExcluded_.end(),detid)!=ModulesToBeExcluded_.end());
+      if (excluded.back()) {
+        layers.push_back(LayerMEsMap.end());
+        subDets.push_back(SubDetMEsMap.end());
+      } else {
+        layers.push_back(LayerMEsMap.find(hidmanager.getSubdetid(detid,flag_ring)));
+        subDets.push_back(SubDetMEsMap.find(folder_organizer.getSubDetFolderAndTag(detid).second));
+      }
+    }
+    partitions.push_back(detSets.size());
+    // produce the conditions read by SiStripClusterInfo on this thread
+    for (size_t d = 0; d < detSets.size(); ++d) {
+      if (excluded[d] || detSets[d].size() == 0) continue;
+      SiStripClusterInfo SiStripClusterInfo_(*detSets[d].begin(),es);
+      break;
+    }
+
+    ClusterQualityCut cut;
+    cut.on       = applyClusterQuality_;
+    cut.minStoN  = sToNLowerLimit_;
+    cut.maxStoN  = sToNUpperLimit_;
+    cut.minWidth = widthLowerLimit_;
+    cut.maxWidth = widthUpperLimit_;
+    std::vector< std::vector< OffTrackCluster > > clusters(partitions.size() - 1);
+    OffTrackClusterBody body(detSets, partitions, excluded, vPSiStripCluster, es, cut, &clusters);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, clusters.size(), 1), body);
+
+    // merge as clusterInfos() and fillMEs() do for "OffTrack"
+    for (size_t p = 0; p < clusters.size(); ++p) {
+      for (std::vector<OffTrackCluster>::const_iterator iCluster = clusters[p].begin(); iCluster != clusters[p].end(); ++iCluster) {
+        std::map<std::string, SubDetMEs>::iterator iSubdet = subDets[iCluster->detSet];
+        std::map<std::string, LayerMEs>::iterator  iLayer  = layers[iCluster->detSet];
+        if (iSubdet != SubDetMEsMap.end()) iSubdet->second.totNClustersOffTrack++;
+        if (iLayer != LayerMEsMap.end()) {
+          fillME(iLayer->second.ClusterChargeOffTrack, iCluster->charge);
+          fillME(iLayer->second.ClusterNoiseOffTrack, iCluster->noise);
+          fillME(iLayer->second.ClusterWidthOffTrack, iCluster->width);
+          fillME(iLayer->second.ClusterPosOffTrack, iCluster->position);
+        }
+        if (iSubdet != SubDetMEsMap.end()) {
+          fillME(iSubdet->second.ClusterChargeOffTrack, iCluster->charge);
+          fillME(iSubdet->second.ClusterStoNOffTrack, iCluster->StoN);
+        }
+        if (TkHistoMap_On_) {
+          tkhisto_NumOffTrack->add(iCluster->detId,1.);
+          if(iCluster->charge > 250){
+            LogDebug("SiStripMonitorTrack") << "Module firing " << detSets[iCluster->detSet].id() << " in Event " << eventNb << std::endl;
+          }
+        }
+      }
+    }
+    return;
+  }
   //Loop on Dets
   for ( edmNew::DetSetVector<SiStripCluster>::const_iterator DSViter=siStripClusterHandle->begin(); DSViter!=siStripClusterHandle->end();DSViter++){
     uint32_t detid=DSViter->id();
@@ -278,25 +278,21 @@ void TrackingMonitor::analyze(const edm::Event& iEvent, const edm::EventSetup& i
     if (trackHandle.isValid())
     {
 
-       reco::TrackCollection trackCollection = *trackHandle;
+        const reco::TrackCollection & trackCollection = *trackHandle;
         // calculate the mean # rechits and layers
         int totalNumTracks = 0, totalRecHits = 0, totalLayers = 0;
 
+        // decode the quality requirement once, not per track
+        bool useQuality = false;
+        reco::TrackBase::TrackQuality trackQuality = reco::TrackBase::undefQuality;
+        if     ( Quality == "highPurity") { useQuality = true; trackQuality = reco::TrackBase::highPurity; }
+        else if( Quality == "tight")      { useQuality = true; trackQuality = reco::TrackBase::tight; }
+        else if( Quality == "loose")      { useQuality = true; trackQuality = reco::TrackBase::loose; }
+
         for (reco::TrackCollection::const_iterator track = trackCollection.begin(); track!=trackCollection.end(); ++track)
         {
 
-            if( Quality == "highPurity")
-            {
-                if( !track->quality(reco::TrackBase::highPurity) ) continue;
-            }
-            else if( Quality == "tight")
-            {
-                if( !track->quality(reco::TrackBase::tight) ) continue;
-            }
-            else if( Quality == "loose")
-            {
-                if( !track->quality(reco::TrackBase::loose) ) continue;
-            }
+            if( useQuality && !track->quality(trackQuality) ) continue;
 
             totalNumTracks++;
             totalRecHits    += track->found();
@@ -383,8 +379,9 @@ void TrackingMonitor::analyze(const edm::Event& iEvent, const edm::EventSetup& i
 	    iEvent.getByLabel("siPixelClusters", pixel_clusters);
             if (strip_clusters.isValid() && pixel_clusters.isValid())
               {
-                unsigned int ncluster_pix   = (*pixel_clusters).size(); // size_type will be better
-                unsigned int ncluster_strip = (*strip_clusters).size(); // size_type will be better
+                // number of clusters, not of modules with clusters; no iteration needed
+                unsigned int ncluster_pix   = (*pixel_clusters).dataSize(); // size_type will be better
+                unsigned int ncluster_strip = (*strip_clusters).dataSize(); // size_type will be better
                 double ratio = 0.0;
                 if ( ncluster_pix > 0) ratio = atan(ncluster_pix*1.0/ncluster_strip);
 
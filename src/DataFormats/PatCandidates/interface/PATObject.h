@@ -32,6 +32,7 @@
 #include "DataFormats/HepMCCandidate/interface/GenParticle.h"
 
 #include "DataFormats/PatCandidates/interface/UserData.h"
+#include "DataFormats/PatCandidates/interface/UserDataHandle.h"
 #include "DataFormats/Common/interface/OwnVector.h"
 
 #include "DataFormats/PatCandidates/interface/CandKinResolution.h"
@@ -194,6 +195,15 @@ namespace pat {
       const TriggerObjectStandAlone * triggerObjectMatchByPath( const char * namePath, const unsigned pathLastFilterAccepted, const unsigned pathL3FilterAccepted = 1, const size_t idx = 0 ) const {
         return triggerObjectMatchByPath( std::string( namePath ), bool( pathLastFilterAccepted ), bool( pathL3FilterAccepted ), idx );
       };
+      /// indices (in 'triggerObjectMatches()') of the matched trigger objects fulfilling a certain criterion;
+      /// these give access to the embedded matches without copying them, e.g. via 'triggerObjectMatch( idx )',
+      /// the criteria are the same as for the corresponding 'triggerObjectMatchesBy...' functions
+      const std::vector< size_t > triggerObjectMatchIndicesByType( const trigger::TriggerObjectType triggerObjectType ) const;
+      const std::vector< size_t > triggerObjectMatchIndicesByCollection( const std::string & coll ) const;
+      const std::vector< size_t > triggerObjectMatchIndicesByCondition( const std::string & nameCondition ) const;
+      const std::vector< size_t > triggerObjectMatchIndicesByAlgorithm( const std::string & nameAlgorithm, const bool algoCondAccepted = true ) const;
+      const std::vector< size_t > triggerObjectMatchIndicesByFilter( const std::string & labelFilter ) const;
+      const std::vector< size_t > triggerObjectMatchIndicesByPath( const std::string & namePath, const bool pathLastFilterAccepted = false, const bool pathL3FilterAccepted = true ) const;
       /// add a trigger match
       void addTriggerObjectMatch( const TriggerObjectStandAlone & trigObj ) { triggerObjectMatchesEmbedded_.push_back( trigObj ); };
 
@@ -272,10 +282,21 @@ namespace pat {
           return (data != 0 ? data->template get<T>() : 0);
 
       }
+      /// Returns user-defined data for a pre-resolved key (see 'userDataHandle')
+      template<typename T> const T * userData(const pat::UserDataHandle &handle) const {
+          const size_t idx = handle.resolve(userDataLabels_);
+          return (idx < userDataObjects_.size() ? userDataObjects_[idx].template get<T>() : 0);
+      }
       /// Check if user data with a specific type is present
       bool hasUserData(const std::string &key) const {
           return (userDataObject_(key) != 0);
       }
+      /// Get a key for repeated access to user-defined data, resolved on this object
+      pat::UserDataHandle userDataHandle(const std::string &key) const {
+          pat::UserDataHandle handle(key);
+          handle.resolve(userDataLabels_);
+          return handle;
+      }
       /// Get human-readable type of user data object, for debugging
       const std::string & userDataObjectType(const std::string &key) const {
           static const std::string EMPTY("");
@@ -314,6 +335,18 @@ namespace pat {
       float userFloat( const std::string & key ) const;
       /// a CINT-friendly interface
       float userFloat( const char* key ) const { return userFloat( std::string(key) ); }
+      /// Get user-defined float for a pre-resolved key (see 'userFloatHandle')
+      float userFloat( const pat::UserDataHandle & handle ) const {
+        const size_t idx = handle.resolve(userFloatLabels_);
+        return (idx < userFloats_.size() ? userFloats_[idx] : 0.0);
+      }
+      /// Get a key for repeated access to a user-defined float, resolved on this object,
+      /// e.g. for loops over a collection
+      pat::UserDataHandle userFloatHandle( const std::string & key ) const {
+        pat::UserDataHandle handle(key);
+        handle.resolve(userFloatLabels_);
+        return handle;
+      }
       
       /// Set user-defined float
       void addUserFloat( const  std::string & label, float data );
@@ -325,10 +358,25 @@ namespace pat {
       }
       /// a CINT-friendly interface
       bool hasUserFloat( const char* key ) const {return hasUserFloat( std::string(key) );}
+      /// Return true if there is a user-defined float for a pre-resolved key
+      bool hasUserFloat( const pat::UserDataHandle & handle ) const {
+        return handle.resolve(userFloatLabels_) < userFloatLabels_.size();
+      }
 
       /// Get user-defined int
       /// Note: it will return 0 if the key is not found; you can check if the key exists with 'hasUserInt' method.
       int32_t userInt( const std::string & key ) const;
+      /// Get user-defined int for a pre-resolved key (see 'userIntHandle')
+      int32_t userInt( const pat::UserDataHandle & handle ) const {
+        const size_t idx = handle.resolve(userIntLabels_);
+        return (idx < userInts_.size() ? userInts_[idx] : 0);
+      }
+      /// Get a key for repeated access to a user-defined int, resolved on this object
+      pat::UserDataHandle userIntHandle( const std::string & key ) const {
+        pat::UserDataHandle handle(key);
+        handle.resolve(userIntLabels_);
+        return handle;
+      }
       /// Set user-defined int
       void addUserInt( const std::string & label,  int32_t data );
       /// Get list of user-defined int names
@@ -337,10 +385,25 @@ namespace pat {
       bool hasUserInt( const std::string & key ) const {
         return std::find(userIntLabels_.begin(), userIntLabels_.end(), key) != userIntLabels_.end();
       }
+      /// Return true if there is a user-defined int for a pre-resolved key
+      bool hasUserInt( const pat::UserDataHandle & handle ) const {
+        return handle.resolve(userIntLabels_) < userIntLabels_.size();
+      }
 
       /// Get user-defined candidate ptr
       /// Note: it will a null pointer if the key is not found; you can check if the key exists with 'hasUserInt' method.
       reco::CandidatePtr userCand( const std::string & key ) const;
+      /// Get user-defined candidate ptr for a pre-resolved key (see 'userCandHandle')
+      reco::CandidatePtr userCand( const pat::UserDataHandle & handle ) const {
+        const size_t idx = handle.resolve(userCandLabels_);
+        return (idx < userCands_.size() ? userCands_[idx] : reco::CandidatePtr());
+      }
+      /// Get a key for repeated access to a user-defined candidate ptr, resolved on this object
+      pat::UserDataHandle userCandHandle( const std::string & key ) const {
+        pat::UserDataHandle handle(key);
+        handle.resolve(userCandLabels_);
+        return handle;
+      }
       /// Set user-defined int
       void addUserCand( const std::string & label,  const reco::CandidatePtr & data );
       /// Get list of user-defined cand names
@@ -349,6 +412,10 @@ namespace pat {
       bool hasUserCand( const std::string & key ) const {
         return std::find(userCandLabels_.begin(), userCandLabels_.end(), key) != userCandLabels_.end();
       }
+      /// Return true if there is a user-defined candidate ptr for a pre-resolved key
+      bool hasUserCand( const pat::UserDataHandle & handle ) const {
+        return handle.resolve(userCandLabels_) < userCandLabels_.size();
+      }
 
       // === New Kinematic Resolutions
       /// Return the kinematic resolutions associated to this object, possibly specifying a label for it.
@@ -443,6 +510,12 @@ namespace pat {
 
     private:
       const pat::UserData *  userDataObject_(const std::string &key) const ;
+      /// copies of the matched trigger objects given by indices
+      const TriggerObjectStandAloneCollection triggerObjectMatchesByIndices_( const std::vector< size_t > & indices ) const;
+      /// the idx-th of the matched trigger objects given by indices, 0 if out of range
+      const TriggerObjectStandAlone * triggerObjectMatchByIndices_( const std::vector< size_t > & indices, const size_t idx ) const {
+        return idx < indices.size() ? &triggerObjectMatchesEmbedded_.at( indices.at( idx ) ) : 0;
+      }
   };
 
 
@@ -489,125 +562,125 @@ namespace pat {
   }
 
   template <class ObjectType>
-  const TriggerObjectStandAloneCollection PATObject<ObjectType>::triggerObjectMatchesByType( const trigger::TriggerObjectType triggerObjectType ) const {
+  const TriggerObjectStandAloneCollection PATObject<ObjectType>::triggerObjectMatchesByIndices_( const std::vector< size_t > & indices ) const {
     TriggerObjectStandAloneCollection matches;
-    for ( size_t i = 0; i < triggerObjectMatches().size(); ++i ) {
-      if ( triggerObjectMatch( i ) != 0 && triggerObjectMatch( i )->hasTriggerObjectType( triggerObjectType ) ) matches.push_back( *( triggerObjectMatch( i ) ) );
-    }
+    matches.reserve( indices.size() );
+    for ( size_t i = 0; i < indices.size(); ++i ) matches.push_back( triggerObjectMatchesEmbedded_.at( indices.at( i ) ) );
     return matches;
   }
 
+  template <class ObjectType>
+  const std::vector< size_t > PATObject<ObjectType>::triggerObjectMatchIndicesByType( const trigger::TriggerObjectType triggerObjectType ) const {
+    std::vector< size_t > indices;
+    for ( size_t i = 0; i < triggerObjectMatchesEmbedded_.size(); ++i ) {
+      if ( triggerObjectMatchesEmbedded_[ i ].hasTriggerObjectType( triggerObjectType ) ) indices.push_back( i );
+    }
+    return indices;
+  }
+
+  template <class ObjectType>
+  const TriggerObjectStandAloneCollection PATObject<ObjectType>::triggerObjectMatchesByType( const trigger::TriggerObjectType triggerObjectType ) const {
+    return triggerObjectMatchesByIndices_( triggerObjectMatchIndicesByType( triggerObjectType ) );
+  }
+
   template <class ObjectType>
   const TriggerObjectStandAlone * PATObject<ObjectType>::triggerObjectMatchByType( const trigger::TriggerObjectType triggerObjectType, const size_t idx ) const {
-    std::vector< size_t > refs;
-    for ( size_t i = 0; i < triggerObjectMatches().size(); ++i ) {
-      if ( triggerObjectMatch( i ) != 0 && triggerObjectMatch( i )->hasTriggerObjectType( triggerObjectType ) ) refs.push_back( i );
+    return triggerObjectMatchByIndices_( triggerObjectMatchIndicesByType( triggerObjectType ), idx );
+  }
+
+  template <class ObjectType>
+  const std::vector< size_t > PATObject<ObjectType>::triggerObjectMatchIndicesByCollection( const std::string & coll ) const {
+    std::vector< size_t > indices;
+    for ( size_t i = 0; i < triggerObjectMatchesEmbedded_.size(); ++i ) {
+      if ( triggerObjectMatchesEmbedded_[ i ].hasCollection( coll ) ) indices.push_back( i );
     }
-    if ( idx >= refs.size() ) return 0;
-    TriggerObjectStandAloneRef ref( &triggerObjectMatchesEmbedded_, refs.at( idx ) );
-    return ref.isNonnull() ? ref.get() : 0;
+    return indices;
   }
 
   template <class ObjectType>
   const TriggerObjectStandAloneCollection PATObject<ObjectType>::triggerObjectMatchesByCollection( const std::string & coll ) const {
-    TriggerObjectStandAloneCollection matches;
-    for ( size_t i = 0; i < triggerObjectMatches().size(); ++i ) {
-      if ( triggerObjectMatch( i ) != 0 && triggerObjectMatch( i )->hasCollection( coll ) ) matches.push_back( *( triggerObjectMatch( i ) ) );
-    }
-    return matches;
+    return triggerObjectMatchesByIndices_( triggerObjectMatchIndicesByCollection( coll ) );
   }
 
   template <class ObjectType>
   const TriggerObjectStandAlone * PATObject<ObjectType>::triggerObjectMatchByCollection( const std::string & coll, const size_t idx ) const {
-    std::vector< size_t > refs;
-    for ( size_t i = 0; i < triggerObjectMatches().size(); ++i ) {
-      if ( triggerObjectMatch( i ) != 0 && triggerObjectMatch( i )->hasCollection( coll ) ) {
-        refs.push_back( i );
-      }
+    return triggerObjectMatchByIndices_( triggerObjectMatchIndicesByCollection( coll ), idx );
+  }
+
+  template <class ObjectType>
+  const std::vector< size_t > PATObject<ObjectType>::triggerObjectMatchIndicesByCondition( const std::string & nameCondition ) const {
+    std::vector< size_t > indices;
+    for ( size_t i = 0; i < triggerObjectMatchesEmbedded_.size(); ++i ) {
+      if ( triggerObjectMatchesEmbedded_[ i ].hasConditionName( nameCondition ) ) indices.push_back( i );
     }
-    if ( idx >= refs.size() ) return 0;
-    TriggerObjectStandAloneRef ref( &triggerObjectMatchesEmbedded_, refs.at( idx ) );
-    return ref.isNonnull() ? ref.get() : 0;
+    return indices;
   }
 
   template <class ObjectType>
   const TriggerObjectStandAloneCollection PATObject<ObjectType>::triggerObjectMatchesByCondition( const std::string & nameCondition ) const {
-    TriggerObjectStandAloneCollection matches;
-    for ( size_t i = 0; i < triggerObjectMatches().size(); ++i ) {
-      if ( triggerObjectMatch( i ) != 0 && triggerObjectMatch( i )->hasConditionName( nameCondition ) ) matches.push_back( *( triggerObjectMatch( i ) ) );
-    }
-    return matches;
+    return triggerObjectMatchesByIndices_( triggerObjectMatchIndicesByCondition( nameCondition ) );
   }
 
   template <class ObjectType>
   const TriggerObjectStandAlone * PATObject<ObjectType>::triggerObjectMatchByCondition( const std::string & nameCondition, const size_t idx ) const {
-    std::vector< size_t > refs;
-    for ( size_t i = 0; i < triggerObjectMatches().size(); ++i ) {
-      if ( triggerObjectMatch( i ) != 0 && triggerObjectMatch( i )->hasConditionName( nameCondition ) ) refs.push_back( i );
+    return triggerObjectMatchByIndices_( triggerObjectMatchIndicesByCondition( nameCondition ), idx );
+  }
+
+  template <class ObjectType>
+  const std::vector< size_t > PATObject<ObjectType>::triggerObjectMatchIndicesByAlgorithm( const std::string & nameAlgorithm, const bool algoCondAccepted ) const {
+    std::vector< size_t > indices;
+    for ( size_t i = 0; i < triggerObjectMatchesEmbedded_.size(); ++i ) {
+      if ( triggerObjectMatchesEmbedded_[ i ].hasAlgorithmName( nameAlgorithm, algoCondAccepted ) ) indices.push_back( i );
     }
-    if ( idx >= refs.size() ) return 0;
-    TriggerObjectStandAloneRef ref( &triggerObjectMatchesEmbedded_, refs.at( idx ) );
-    return ref.isNonnull() ? ref.get() : 0;
+    return indices;
   }
 
   template <class ObjectType>
   const TriggerObjectStandAloneCollection PATObject<ObjectType>::triggerObjectMatchesByAlgorithm( const std::string & nameAlgorithm, const bool algoCondAccepted ) const {
-    TriggerObjectStandAloneCollection matches;
-    for ( size_t i = 0; i < triggerObjectMatches().size(); ++i ) {
-      if ( triggerObjectMatch( i ) != 0 && triggerObjectMatch( i )->hasAlgorithmName( nameAlgorithm, algoCondAccepted ) ) matches.push_back( *( triggerObjectMatch( i ) ) );
-    }
-    return matches;
+    return triggerObjectMatchesByIndices_( triggerObjectMatchIndicesByAlgorithm( nameAlgorithm, algoCondAccepted ) );
   }
 
   template <class ObjectType>
   const TriggerObjectStandAlone * PATObject<ObjectType>::triggerObjectMatchByAlgorithm( const std::string & nameAlgorithm, const bool algoCondAccepted, const size_t idx ) const {
-    std::vector< size_t > refs;
-    for ( size_t i = 0; i < triggerObjectMatches().size(); ++i ) {
-      if ( triggerObjectMatch( i ) != 0 && triggerObjectMatch( i )->hasAlgorithmName( nameAlgorithm, algoCondAccepted ) ) refs.push_back( i );
+    return triggerObjectMatchByIndices_( triggerObjectMatchIndicesByAlgorithm( nameAlgorithm, algoCondAccepted ), idx );
+  }
+
+  template <class ObjectType>
+  const std::vector< size_t > PATObject<ObjectType>::triggerObjectMatchIndicesByFilter( const std::string & labelFilter ) const {
+    std::vector< size_t > indices;
+    for ( size_t i = 0; i < triggerObjectMatchesEmbedded_.size(); ++i ) {
+      if ( triggerObjectMatchesEmbedded_[ i ].hasFilterLabel( labelFilter ) ) indices.push_back( i );
     }
-    if ( idx >= refs.size() ) return 0;
-    TriggerObjectStandAloneRef ref( &triggerObjectMatchesEmbedded_, refs.at( idx ) );
-    return ref.isNonnull() ? ref.get() : 0;
+    return indices;
   }
 
   template <class ObjectType>
   const TriggerObjectStandAloneCollection PATObject<ObjectType>::triggerObjectMatchesByFilter( const std::string & labelFilter ) const {
-    TriggerObjectStandAloneCollection matches;
-    for ( size_t i = 0; i < triggerObjectMatches().size(); ++i ) {
-      if ( triggerObjectMatch( i ) != 0 && triggerObjectMatch( i )->hasFilterLabel( labelFilter ) ) matches.push_back( *( triggerObjectMatch( i ) ) );
-    }
-    return matches;
+    return triggerObjectMatchesByIndices_( triggerObjectMatchIndicesByFilter( labelFilter ) );
   }
 
   template <class ObjectType>
   const TriggerObjectStandAlone * PATObject<ObjectType>::triggerObjectMatchByFilter( const std::string & labelFilter, const size_t idx ) const {
-    std::vector< size_t > refs;
-    for ( size_t i = 0; i < triggerObjectMatches().size(); ++i ) {
-      if ( triggerObjectMatch( i ) != 0 && triggerObjectMatch( i )->hasFilterLabel( labelFilter ) ) refs.push_back( i );
+    return triggerObjectMatchByIndices_( triggerObjectMatchIndicesByFilter( labelFilter ), idx );
+  }
+
+  template <class ObjectType>
+  const std::vector< size_t > PATObject<ObjectType>::triggerObjectMatchIndicesByPath( const std::string & namePath, const bool pathLastFilterAccepted, const bool pathL3FilterAccepted ) const {
+    std::vector< size_t > indices;
+    for ( size_t i = 0; i < triggerObjectMatchesEmbedded_.size(); ++i ) {
+      if ( triggerObjectMatchesEmbedded_[ i ].hasPathName( namePath, pathLastFilterAccepted, pathL3FilterAccepted ) ) indices.push_back( i );
     }
-    if ( idx >= refs.size() ) return 0;
-    TriggerObjectStandAloneRef ref( &triggerObjectMatchesEmbedded_, refs.at( idx ) );
-    return ref.isNonnull() ? ref.get() : 0;
+    return indices;
   }
 
   template <class ObjectType>
   const TriggerObjectStandAloneCollection PATObject<ObjectType>::triggerObjectMatchesByPath( const std::string & namePath, const bool pathLastFilterAccepted, const bool pathL3FilterAccepted ) const {
-    TriggerObjectStandAloneCollection matches;
-    for ( size_t i = 0; i < triggerObjectMatches().size(); ++i ) {
-      if ( triggerObjectMatch( i ) != 0 && triggerObjectMatch( i )->hasPathName( namePath, pathLastFilterAccepted, pathL3FilterAccepted ) ) matches.push_back( *( triggerObjectMatch( i ) ) );
-    }
-    return matches;
+    return triggerObjectMatchesByIndices_( triggerObjectMatchIndicesByPath( namePath, pathLastFilterAccepted, pathL3FilterAccepted ) );
   }
 
   template <class ObjectType>
   const TriggerObjectStandAlone * PATObject<ObjectType>::triggerObjectMatchByPath( const std::string & namePath, const bool pathLastFilterAccepted, const bool pathL3FilterAccepted, const size_t idx ) const {
-    std::vector< size_t > refs;
-    for ( size_t i = 0; i < triggerObjectMatches().size(); ++i ) {
-      if ( triggerObjectMatch( i ) != 0 && triggerObjectMatch( i )->hasPathName( namePath, pathLastFilterAccepted, pathL3FilterAccepted ) ) refs.push_back( i );
-    }
-    if ( idx >= refs.size() ) return 0;
-    TriggerObjectStandAloneRef ref( &triggerObjectMatchesEmbedded_, refs.at( idx ) );
-    return ref.isNonnull() ? ref.get() : 0;
+    return triggerObjectMatchByIndices_( triggerObjectMatchIndicesByPath( namePath, pathLastFilterAccepted, pathL3FilterAccepted ), idx );
   }
 
   template <class ObjectType>
@@ -0,0 +1,206 @@
+#ifndef DataFormats_PatCandidates_PackedTriggerObjectStandAlone_h
+#define DataFormats_PatCandidates_PackedTriggerObjectStandAlone_h
+
+
+// -*- C++ -*-
+//
+// Package:    PatCandidates
+// Class:      pat::PackedTriggerObjectStandAloneCollection
+//
+// $Id$
+//
+/**
+  \class    pat::PackedTriggerObjectStandAloneCollection PackedTriggerObjectStandAlone.h "DataFormats/PatCandidates/interface/PackedTriggerObjectStandAlone.h"
+  \brief    Compact persistent representation of a TriggerObjectStandAloneCollection
+
+   PackedTriggerObjectStandAloneCollection stores the content of a TriggerObjectStandAloneCollection
+   column-wise:
+   - the kinematics with reduced precision (pt and mass as float, eta and phi as 16 bit integers
+     with a resolution of 0.001 and 1e-4 respectively),
+   - the collection name as an index into the collection name table,
+   - the HLT filter labels (L1 condition names) and HLT path names (L1 algorithm names) as bit positions
+     into the filter and path name tables, together with the bits of the path usage indicators.
+   The name tables are not part of the event product. They are kept in a
+   PackedTriggerObjectStandAloneTable, which collects the names of all events packed with it and is
+   written once per run (s. PackedTriggerObjectStandAloneTables).
+   The unpacking restores TriggerObjectStandAlone objects with the names in the order of the tables.
+   References to the original objects ('origObjRef()') are not kept.
+
+  \class    pat::PackedTriggerObjectStandAloneTable PackedTriggerObjectStandAlone.h "DataFormats/PatCandidates/interface/PackedTriggerObjectStandAlone.h"
+  \brief    Name tables of packed stand-alone trigger objects
+
+   PackedTriggerObjectStandAloneTable holds the collection, filter and path names referred to by
+   PackedTriggerObjectStandAloneCollection. Names are only appended, so indices and bit positions
+   stay valid while the table grows during a run.
+   A table is identified within its run by the luminosity block and event number of the first event
+   packed with it. This key is unique also for tables filled in different jobs of the same run.
+
+  \class    pat::PackedTriggerObjectStandAloneTables PackedTriggerObjectStandAlone.h "DataFormats/PatCandidates/interface/PackedTriggerObjectStandAlone.h"
+  \brief    Run product of the name tables of packed stand-alone trigger objects
+
+   PackedTriggerObjectStandAloneTables holds all tables used in a run. Merging the run products of
+   several jobs (files) keeps the tables of all of them.
+
+  \version  $Id$
+*/
+
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "DataFormats/PatCandidates/interface/TriggerObjectStandAlone.h"
+
+
+namespace pat {
+
+  class PackedTriggerObjectStandAloneTable {
+
+      /// Data Members
+
+      /// Key: luminosity block and event number of the first event packed with this table
+      unsigned luminosityBlock_;
+      unsigned event_;
+      /// Name tables
+      std::vector< std::string > collectionNames_;
+      /// HLT filter labels and L1 condition names
+      std::vector< std::string > filterNames_;
+      /// HLT path names and L1 algorithm names
+      std::vector< std::string > pathNames_;
+      /// Transient look-up of the indices by name
+      std::map< std::string, unsigned > collectionIndices_;
+      std::map< std::string, unsigned > filterIndices_;
+      std::map< std::string, unsigned > pathIndices_;
+
+    public:
+
+      /// Constructors and Destructor
+
+      /// Default constructor
+      PackedTriggerObjectStandAloneTable();
+      /// Constructor of an empty table with its key
+      PackedTriggerObjectStandAloneTable( unsigned luminosityBlock, unsigned event );
+
+      /// Destructor
+      virtual ~PackedTriggerObjectStandAloneTable() {};
+
+      /// Methods
+
+      /// Key
+      unsigned luminosityBlock() const { return luminosityBlock_; };
+      unsigned event() const { return event_; };
+      bool hasKey( unsigned luminosityBlock, unsigned event ) const { return ( luminosityBlock_ == luminosityBlock && event_ == event ); };
+      /// Name tables
+      const std::vector< std::string > & collectionNames() const { return collectionNames_; };
+      const std::vector< std::string > & filterNames() const { return filterNames_; };
+      const std::vector< std::string > & pathNames() const { return pathNames_; };
+      /// Indices of names, unknown names are appended
+      unsigned collectionIndex( const std::string & name ) { return index( name, collectionNames_, collectionIndices_ ); };
+      unsigned filterIndex( const std::string & name ) { return index( name, filterNames_, filterIndices_ ); };
+      unsigned pathIndex( const std::string & name ) { return index( name, pathNames_, pathIndices_ ); };
+
+    private:
+
+      /// Index of 'name' in 'names', appends unknown names
+      /// The look-up is rebuilt, if the table was read from file.
+      static unsigned index( const std::string & name, std::vector< std::string > & names, std::map< std::string, unsigned > & indices );
+
+  };
+
+
+  class PackedTriggerObjectStandAloneTables {
+
+      /// Data Members
+
+      std::vector< PackedTriggerObjectStandAloneTable > tables_;
+
+    public:
+
+      /// Constructors and Destructor
+
+      /// Default constructor
+      PackedTriggerObjectStandAloneTables() {};
+
+      /// Destructor
+      virtual ~PackedTriggerObjectStandAloneTables() {};
+
+      /// Methods
+
+      /// Number of tables
+      size_t size() const { return tables_.size(); };
+      /// Adds a table, if no table with the same key is present
+      void add( const PackedTriggerObjectStandAloneTable & table );
+      /// Table with the given key; 0, if not found
+      const PackedTriggerObjectStandAloneTable * find( unsigned luminosityBlock, unsigned event ) const;
+      /// Merges the tables of another run product
+      bool mergeProduct( const PackedTriggerObjectStandAloneTables & other );
+
+  };
+
+
+  class PackedTriggerObjectStandAloneCollection {
+
+      /// Data Members
+
+      /// Key of the name table
+      unsigned tableLuminosityBlock_;
+      unsigned tableEvent_;
+      /// Kinematics, one entry per object
+      std::vector< float >          pt_;
+      std::vector< short >          eta_;
+      std::vector< short >          phi_;
+      std::vector< float >          mass_;
+      std::vector< int >            pdgId_;
+      std::vector< signed char >    charge_;
+      /// Index in the collection name table, one entry per object
+      std::vector< unsigned short > collectionIndices_;
+      /// Trigger object types of object 'i' in [ typeOffsets_[ i ], typeOffsets_[ i + 1 ] )
+      std::vector< unsigned >       typeOffsets_;
+      std::vector< short >          types_;
+      /// Availability of the path usage indicators, one entry per object
+      std::vector< unsigned char >  flags_;
+      /// Bit words per object for the filter and path tables
+      unsigned                      filterWords_;
+      unsigned                      pathWords_;
+      /// Membership bits, 'filterWords_' or 'pathWords_' words per object
+      std::vector< unsigned >       filterBits_;
+      std::vector< unsigned >       pathBits_;
+      std::vector< unsigned >       pathLastFilterBits_;
+      std::vector< unsigned >       pathL3FilterBits_;
+
+      /// Flags
+      enum { hasLastFilter = 1, hasL3Filter = 2 };
+
+    public:
+
+      /// Constructors and Destructor
+
+      /// Default constructor
+      PackedTriggerObjectStandAloneCollection();
+      /// Constructor packing a TriggerObjectStandAloneCollection
+      /// Names not yet in 'table' are appended to it.
+      PackedTriggerObjectStandAloneCollection( const TriggerObjectStandAloneCollection & objects, PackedTriggerObjectStandAloneTable & table );
+
+      /// Destructor
+      virtual ~PackedTriggerObjectStandAloneCollection() {};
+
+      /// Methods
+
+      /// Number of packed objects
+      size_t size() const { return pt_.size(); };
+      /// Key of the name table
+      unsigned tableLuminosityBlock() const { return tableLuminosityBlock_; };
+      unsigned tableEvent() const { return tableEvent_; };
+      /// Name table of this collection in the run product; 0, if not found
+      const PackedTriggerObjectStandAloneTable * table( const PackedTriggerObjectStandAloneTables & tables ) const { return tables.find( tableLuminosityBlock_, tableEvent_ ); };
+      /// Unpacks the object with index 'index' with the names from 'table'
+      TriggerObjectStandAlone unpack( size_t index, const PackedTriggerObjectStandAloneTable & table ) const;
+      /// Unpacks all objects with the names from 'table'
+      TriggerObjectStandAloneCollection unpack( const PackedTriggerObjectStandAloneTable & table ) const;
+
+  };
+
+}
+
+
+#endif
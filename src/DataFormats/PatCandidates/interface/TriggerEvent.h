@@ -94,6 +94,31 @@ namespace pat {
       /// Table of references to pat::TriggerObjectMatch associations in event
       TriggerObjectMatchContainer objectMatchResults_;
 
+      /// Transient reverse indices for the object x-links,
+      /// built on first use by 'buildLinks()' (compressed row layout: entries of row i in [offsets[i],offsets[i+1]) )
+      /// 'true', if the reverse indices are valid
+      mutable bool linksBuilt_;
+      /// Sorted object keys per condition
+      mutable std::vector< unsigned > conditionObjectOffsets_;
+      mutable std::vector< unsigned > conditionObjectKeys_;
+      /// Sorted condition keys per object
+      mutable std::vector< unsigned > objectConditionOffsets_;
+      mutable std::vector< unsigned > objectConditionKeys_;
+      /// Sorted object keys per filter
+      mutable std::vector< unsigned > filterObjectOffsets_;
+      mutable std::vector< unsigned > filterObjectKeys_;
+      /// Sorted filter keys per object
+      mutable std::vector< unsigned > objectFilterOffsets_;
+      mutable std::vector< unsigned > objectFilterKeys_;
+      /// Distinct object collection names and the collection id per object
+      mutable std::vector< std::string > collectionNames_;
+      mutable std::vector< unsigned >    objectCollectionIds_;
+
+      /// Build the reverse indices, if not yet done
+      void buildLinks() const;
+      /// Collection names of the objects given by sorted keys
+      std::vector< std::string > linkedCollections( std::vector< unsigned >::const_iterator begin, std::vector< unsigned >::const_iterator end ) const;
+
     public:
 
       /// Constructors and Desctructor
@@ -216,7 +241,7 @@ namespace pat {
 
       /// L1 conditions
       /// Set the reference to the pat::TriggerConditionCollection in the event
-      void setConditions( const edm::Handle< TriggerConditionCollection > & handleTriggerConditions ) { conditions_ = TriggerConditionRefProd( handleTriggerConditions ); };
+      void setConditions( const edm::Handle< TriggerConditionCollection > & handleTriggerConditions ) { conditions_ = TriggerConditionRefProd( handleTriggerConditions ); linksBuilt_ = false; };
       /// Get a pointer to all L1 condition,
       /// returns 0, if RefProd is NULL
       const TriggerConditionCollection * conditions() const { return conditions_.get(); };
@@ -258,7 +283,7 @@ namespace pat {
 
       /// HLT filters
       /// Set the reference to the pat::TriggerFilterCollection in the event
-      void setFilters( const edm::Handle< TriggerFilterCollection > & handleTriggerFilters ) { filters_ = TriggerFilterRefProd( handleTriggerFilters ); };
+      void setFilters( const edm::Handle< TriggerFilterCollection > & handleTriggerFilters ) { filters_ = TriggerFilterRefProd( handleTriggerFilters ); linksBuilt_ = false; };
       /// Get a pointer to all HLT filters,
       /// returns 0, if RefProd is NULL
       const TriggerFilterCollection * filters() const { return filters_.get(); };
@@ -279,7 +304,7 @@ namespace pat {
 
       /// Trigger objects
       /// Set the reference to the pat::TriggerObjectCollection in the event
-      void setObjects( const edm::Handle< TriggerObjectCollection > & handleTriggerObjects ) { objects_ = TriggerObjectRefProd( handleTriggerObjects ); };
+      void setObjects( const edm::Handle< TriggerObjectCollection > & handleTriggerObjects ) { objects_ = TriggerObjectRefProd( handleTriggerObjects ); linksBuilt_ = false; };
       /// Get a pointer to all trigger objects,
       /// returns 0, if RefProd is NULL
       const TriggerObjectCollection * objects() const { return objects_.get(); };
@@ -29,8 +29,13 @@
 
 namespace pat {
 
+  class PackedTriggerObjectStandAloneCollection;
+
   class TriggerObjectStandAlone : public TriggerObject {
 
+      /// Access to the data members for the packing
+      friend class PackedTriggerObjectStandAloneCollection;
+
       /// Data Members
       /// Keeping the old names of the data members for backward compatibility,
       /// although they refer only to HLT objects.
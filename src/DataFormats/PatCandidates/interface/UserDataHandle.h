@@ -0,0 +1,64 @@
+//
+// $Id$
+//
+
+#ifndef DataFormats_PatCandidates_UserDataHandle_h
+#define DataFormats_PatCandidates_UserDataHandle_h
+
+/**
+  \class    pat::UserDataHandle UserDataHandle.h "DataFormats/PatCandidates/interface/UserDataHandle.h"
+  \brief    Pre-resolved key for the user data of PAT objects
+
+   UserDataHandle holds a user data label together with the position at which it was last found
+   in the label list of a PAT object. All objects of a collection filled by the same
+   PATUserDataHelper configuration share the label order, so a handle resolved once (e.g. with
+   'PATObject::userFloatHandle("relIso")') gives access to the value of every object by a single
+   string comparison instead of a search through the labels.
+   If an object has a different label order, the lookup falls back to the search and the handle
+   is re-resolved on that object.
+
+   A handle should only be used for one kind of user data (float, int, cand or data object).
+
+  \version  $Id$
+*/
+
+
+#include <string>
+#include <vector>
+#include <algorithm>
+
+
+namespace pat {
+
+
+  class UserDataHandle {
+
+    public:
+
+      /// constructor from label, not yet resolved
+      explicit UserDataHandle( const std::string & label ) : label_( label ), index_( 0 ) {};
+
+      /// the user data label
+      const std::string & label() const { return label_; };
+
+      /// position of the label in 'labels', labels.size() if not found;
+      /// remembers the position for the next lookup
+      size_t resolve( const std::vector< std::string > & labels ) const {
+        if ( index_ < labels.size() && labels[ index_ ] == label_ ) return index_;
+        const std::vector< std::string >::const_iterator it( std::find( labels.begin(), labels.end(), label_ ) );
+        if ( it == labels.end() ) return labels.size();
+        index_ = it - labels.begin();
+        return index_;
+      };
+
+    private:
+
+      std::string label_;
+      mutable size_t index_;
+
+  };
+
+
+}
+
+#endif
@@ -0,0 +1,220 @@
+//
+// $Id$
+//
+
+#include "DataFormats/PatCandidates/interface/PackedTriggerObjectStandAlone.h"
+
+#include <cmath>
+#include <algorithm>
+
+
+using namespace pat;
+
+
+namespace {
+
+  /// Resolutions of the packed eta and phi
+  const double etaScale( 1000. );
+  const double phiScale( 10000. );
+
+  short packAngle( double value, double scale )
+  {
+    const double packed( std::floor( value * scale + 0.5 ) );
+    if ( packed >  32767. ) return  32767;
+    if ( packed < -32767. ) return -32767;
+    return short( packed );
+  }
+
+  void setBit( std::vector< unsigned > & bits, size_t first, unsigned position )
+  {
+    bits.at( first + position / 32 ) |= ( 1u << ( position % 32 ) );
+  }
+
+  bool testBit( const std::vector< unsigned > & bits, size_t first, unsigned position )
+  {
+    return bits.at( first + position / 32 ) & ( 1u << ( position % 32 ) );
+  }
+
+}
+
+
+// PackedTriggerObjectStandAloneTable
+
+
+// Default constructor
+PackedTriggerObjectStandAloneTable::PackedTriggerObjectStandAloneTable() :
+  luminosityBlock_( 0 ),
+  event_( 0 )
+{
+}
+
+
+// Constructor of an empty table with its key
+PackedTriggerObjectStandAloneTable::PackedTriggerObjectStandAloneTable( unsigned luminosityBlock, unsigned event ) :
+  luminosityBlock_( luminosityBlock ),
+  event_( event )
+{
+}
+
+
+// Index of 'name' in 'names', appends unknown names
+unsigned PackedTriggerObjectStandAloneTable::index( const std::string & name, std::vector< std::string > & names, std::map< std::string, unsigned > & indices )
+{
+  if ( indices.size() != names.size() ) {
+    indices.clear();
+    for ( unsigned iName = 0; iName < names.size(); ++iName ) indices.insert( std::make_pair( names[ iName ], iName ) );
+  }
+  std::map< std::string, unsigned >::const_iterator iIndex( indices.find( name ) );
+  if ( iIndex != indices.end() ) return iIndex->second;
+  const unsigned index( names.size() );
+  indices.insert( std::make_pair( name, index ) );
+  names.push_back( name );
+  return index;
+}
+
+
+// PackedTriggerObjectStandAloneTables
+
+
+// Adds a table, if no table with the same key is present
+void PackedTriggerObjectStandAloneTables::add( const PackedTriggerObjectStandAloneTable & table )
+{
+  if ( find( table.luminosityBlock(), table.event() ) == 0 ) tables_.push_back( table );
+}
+
+
+// Table with the given key; 0, if not found
+const PackedTriggerObjectStandAloneTable * PackedTriggerObjectStandAloneTables::find( unsigned luminosityBlock, unsigned event ) const
+{
+  for ( std::vector< PackedTriggerObjectStandAloneTable >::const_iterator iTable = tables_.begin(); iTable != tables_.end(); ++iTable ) {
+    if ( iTable->hasKey( luminosityBlock, event ) ) return &( *iTable );
+  }
+  return 0;
+}
+
+
+// Merges the tables of another run product
+bool PackedTriggerObjectStandAloneTables::mergeProduct( const PackedTriggerObjectStandAloneTables & other )
+{
+  for ( std::vector< PackedTriggerObjectStandAloneTable >::const_iterator iTable = other.tables_.begin(); iTable != other.tables_.end(); ++iTable ) add( *iTable );
+  return true;
+}
+
+
+// PackedTriggerObjectStandAloneCollection
+
+
+// Default constructor
+PackedTriggerObjectStandAloneCollection::PackedTriggerObjectStandAloneCollection() :
+  tableLuminosityBlock_( 0 ),
+  tableEvent_( 0 ),
+  filterWords_( 0 ),
+  pathWords_( 0 )
+{
+  typeOffsets_.push_back( 0 );
+}
+
+
+// Constructor packing a TriggerObjectStandAloneCollection
+PackedTriggerObjectStandAloneCollection::PackedTriggerObjectStandAloneCollection( const TriggerObjectStandAloneCollection & objects, PackedTriggerObjectStandAloneTable & table ) :
+  tableLuminosityBlock_( table.luminosityBlock() ),
+  tableEvent_( table.event() ),
+  filterWords_( 0 ),
+  pathWords_( 0 )
+{
+  const size_t sizeObjects( objects.size() );
+
+  // Indices into the name tables, unknown names are appended
+  std::vector< std::vector< unsigned > > filterPositions( sizeObjects );
+  std::vector< std::vector< unsigned > > pathPositions( sizeObjects );
+  collectionIndices_.reserve( sizeObjects );
+  for ( size_t iObj = 0; iObj < sizeObjects; ++iObj ) {
+    const TriggerObjectStandAlone & obj( objects[ iObj ] );
+    collectionIndices_.push_back( table.collectionIndex( obj.collection() ) );
+    filterPositions[ iObj ].reserve( obj.filterLabels_.size() );
+    for ( size_t iF = 0; iF < obj.filterLabels_.size(); ++iF ) filterPositions[ iObj ].push_back( table.filterIndex( obj.filterLabels_[ iF ] ) );
+    pathPositions[ iObj ].reserve( obj.pathNames_.size() );
+    for ( size_t iP = 0; iP < obj.pathNames_.size(); ++iP )    pathPositions[ iObj ].push_back( table.pathIndex( obj.pathNames_[ iP ] ) );
+  }
+  filterWords_ = ( table.filterNames().size() + 31 ) / 32;
+  pathWords_   = ( table.pathNames().size() + 31 ) / 32;
+
+  // Objects
+  pt_.reserve( sizeObjects );
+  eta_.reserve( sizeObjects );
+  phi_.reserve( sizeObjects );
+  mass_.reserve( sizeObjects );
+  pdgId_.reserve( sizeObjects );
+  charge_.reserve( sizeObjects );
+  typeOffsets_.reserve( sizeObjects + 1 );
+  flags_.reserve( sizeObjects );
+  filterBits_.assign( sizeObjects * filterWords_, 0 );
+  pathBits_.assign( sizeObjects * pathWords_, 0 );
+  pathLastFilterBits_.assign( sizeObjects * pathWords_, 0 );
+  pathL3FilterBits_.assign( sizeObjects * pathWords_, 0 );
+  typeOffsets_.push_back( 0 );
+  for ( size_t iObj = 0; iObj < sizeObjects; ++iObj ) {
+    const TriggerObjectStandAlone & obj( objects[ iObj ] );
+    pt_.push_back( obj.pt() );
+    eta_.push_back( packAngle( obj.eta(), etaScale ) );
+    phi_.push_back( packAngle( obj.phi(), phiScale ) );
+    mass_.push_back( obj.mass() );
+    pdgId_.push_back( obj.pdgId() );
+    charge_.push_back( ( signed char )( obj.charge() ) );
+    const std::vector< int > types( obj.triggerObjectTypes() );
+    for ( size_t iT = 0; iT < types.size(); ++iT ) types_.push_back( short( types[ iT ] ) );
+    typeOffsets_.push_back( types_.size() );
+    unsigned char flags( 0 );
+    if ( obj.hasLastFilter() ) flags |= hasLastFilter;
+    if ( obj.hasL3Filter() )   flags |= hasL3Filter;
+    flags_.push_back( flags );
+    for ( size_t iF = 0; iF < filterPositions[ iObj ].size(); ++iF ) {
+      setBit( filterBits_, iObj * filterWords_, filterPositions[ iObj ][ iF ] );
+    }
+    for ( size_t iP = 0; iP < pathPositions[ iObj ].size(); ++iP ) {
+      const unsigned position( pathPositions[ iObj ][ iP ] );
+      setBit( pathBits_, iObj * pathWords_, position );
+      if ( ( flags & hasLastFilter ) && obj.pathLastFilterAccepted_[ iP ] ) setBit( pathLastFilterBits_, iObj * pathWords_, position );
+      if ( ( flags & hasL3Filter )   && obj.pathL3FilterAccepted_[ iP ] )   setBit( pathL3FilterBits_, iObj * pathWords_, position );
+    }
+  }
+}
+
+
+// Methods
+
+
+// Unpacks the object with index 'index' with the names from 'table'
+TriggerObjectStandAlone PackedTriggerObjectStandAloneCollection::unpack( size_t index, const PackedTriggerObjectStandAloneTable & table ) const
+{
+  const reco::Particle::PolarLorentzVector p4( pt_.at( index ), eta_.at( index ) / etaScale, phi_.at( index ) / phiScale, mass_.at( index ) );
+  TriggerObjectStandAlone obj( p4, pdgId_.at( index ) );
+  obj.setCharge( charge_.at( index ) );
+  obj.setCollection( table.collectionNames().at( collectionIndices_.at( index ) ) );
+  for ( unsigned iT = typeOffsets_.at( index ); iT < typeOffsets_.at( index + 1 ); ++iT ) obj.addTriggerObjectType( trigger::TriggerObjectType( types_[ iT ] ) );
+  // The table may have grown after this event was packed
+  const unsigned sizeFilters( std::min( ( unsigned )table.filterNames().size(), 32 * filterWords_ ) );
+  for ( unsigned iF = 0; iF < sizeFilters; ++iF ) {
+    if ( testBit( filterBits_, index * filterWords_, iF ) ) obj.filterLabels_.push_back( table.filterNames()[ iF ] );
+  }
+  const bool lastFilter( flags_.at( index ) & hasLastFilter );
+  const bool l3Filter( flags_.at( index ) & hasL3Filter );
+  const unsigned sizePaths( std::min( ( unsigned )table.pathNames().size(), 32 * pathWords_ ) );
+  for ( unsigned iP = 0; iP < sizePaths; ++iP ) {
+    if ( ! testBit( pathBits_, index * pathWords_, iP ) ) continue;
+    obj.pathNames_.push_back( table.pathNames()[ iP ] );
+    if ( lastFilter ) obj.pathLastFilterAccepted_.push_back( testBit( pathLastFilterBits_, index * pathWords_, iP ) );
+    if ( l3Filter )   obj.pathL3FilterAccepted_.push_back( testBit( pathL3FilterBits_, index * pathWords_, iP ) );
+  }
+  return obj;
+}
+
+
+// Unpacks all objects with the names from 'table'
+TriggerObjectStandAloneCollection PackedTriggerObjectStandAloneCollection::unpack( const PackedTriggerObjectStandAloneTable & table ) const
+{
+  TriggerObjectStandAloneCollection objects;
+  objects.reserve( size() );
+  for ( size_t iObj = 0; iObj < size(); ++iObj ) objects.push_back( unpack( iObj, table ) );
+  return objects;
+}
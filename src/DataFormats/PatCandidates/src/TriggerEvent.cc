@@ -5,10 +5,54 @@
 
 #include "DataFormats/PatCandidates/interface/TriggerEvent.h"
 
+#include <algorithm>
+#include <map>
+
 
 using namespace pat;
 
 
+namespace {
+
+  // Fill the compressed rows 'element -> sorted object keys' of a trigger element collection
+  // and the transposed rows 'object -> sorted element keys'
+  template< class C >
+  void fillObjectLinks( const C * elements, unsigned nObjects,
+                        std::vector< unsigned > & offsets, std::vector< unsigned > & keys,
+                        std::vector< unsigned > & objectOffsets, std::vector< unsigned > & objectKeys )
+  {
+    offsets.assign( 1, 0 );
+    keys.clear();
+    std::vector< unsigned > nObjectKeys( nObjects + 1, 0 );
+    if ( elements ) {
+      for ( typename C::const_iterator iElement = elements->begin(); iElement != elements->end(); ++iElement ) {
+        const std::vector< unsigned >::difference_type first( keys.size() );
+        for ( std::vector< unsigned >::const_iterator iKey = iElement->objectKeys().begin(); iKey != iElement->objectKeys().end(); ++iKey ) {
+          if ( *iKey < nObjects ) keys.push_back( *iKey );
+        }
+        std::sort( keys.begin() + first, keys.end() );
+        keys.erase( std::unique( keys.begin() + first, keys.end() ), keys.end() );
+        for ( std::vector< unsigned >::const_iterator iKey = keys.begin() + first; iKey != keys.end(); ++iKey ) ++nObjectKeys.at( *iKey + 1 );
+        offsets.push_back( keys.size() );
+      }
+    }
+    // elements are visited in ascending order, so the transposed rows come out sorted
+    objectOffsets.resize( nObjects + 1 );
+    unsigned offset( 0 );
+    for ( unsigned iO = 0; iO <= nObjects; ++iO ) {
+      offset += nObjectKeys.at( iO );
+      objectOffsets.at( iO ) = offset;
+    }
+    objectKeys.resize( keys.size() );
+    std::vector< unsigned > next( objectOffsets.begin(), objectOffsets.end() - 1 );
+    for ( unsigned iE = 0; iE + 1 < offsets.size(); ++iE ) {
+      for ( unsigned iK = offsets.at( iE ); iK < offsets.at( iE + 1 ); ++iK ) objectKeys.at( next.at( keys.at( iK ) )++ ) = iE;
+    }
+  }
+
+}
+
+
 // Constructors and Destructor
 
 
@@ -29,7 +73,8 @@ TriggerEvent::TriggerEvent() :
   turnCount_(),
   bCurrentStart_(),
   bCurrentStop_(),
-  bCurrentAvg_()
+  bCurrentAvg_(),
+  linksBuilt_( false )
 {
   objectMatchResults_.clear();
 }
@@ -52,7 +97,8 @@ TriggerEvent::TriggerEvent( const std::string & nameHltTable, bool run, bool acc
   turnCount_(),
   bCurrentStart_(),
   bCurrentStop_(),
-  bCurrentAvg_()
+  bCurrentAvg_(),
+  linksBuilt_( false )
 {
   objectMatchResults_.clear();
 }
@@ -75,7 +121,8 @@ TriggerEvent::TriggerEvent( const std::string & nameL1Menu, const std::string &
   turnCount_(),
   bCurrentStart_(),
   bCurrentStop_(),
-  bCurrentAvg_()
+  bCurrentAvg_(),
+  linksBuilt_( false )
 {
   objectMatchResults_.clear();
 }
@@ -498,25 +545,10 @@ TriggerAlgorithmRefVector TriggerEvent::conditionAlgorithms( const TriggerCondit
 // Get a list of all trigger object collections used in a certain condition given by name
 std::vector< std::string > TriggerEvent::conditionCollections( const std::string & nameCondition ) const
 {
-  std::vector< std::string > theConditionCollections;
-  if ( const TriggerCondition * conditionPtr = condition( nameCondition ) ) {
-    for ( unsigned iObject = 0; iObject < objects()->size(); ++iObject ) {
-      if ( conditionPtr->hasObjectKey( iObject ) ) {
-        bool found( false );
-        std::string objectCollection( objects()->at( iObject ).collection() );
-        for ( std::vector< std::string >::const_iterator iC = theConditionCollections.begin(); iC != theConditionCollections.end(); ++iC ) {
-          if ( *iC == objectCollection ) {
-            found = true;
-            break;
-          }
-        }
-        if ( ! found ) {
-          theConditionCollections.push_back( objectCollection );
-        }
-      }
-    }
-  }
-  return theConditionCollections;
+  const unsigned iCondition( indexCondition( nameCondition ) );
+  if ( iCondition == conditions()->size() ) return std::vector< std::string >();
+  buildLinks();
+  return linkedCollections( conditionObjectKeys_.begin() + conditionObjectOffsets_.at( iCondition ), conditionObjectKeys_.begin() + conditionObjectOffsets_.at( iCondition + 1 ) );
 }
 
 
@@ -524,12 +556,12 @@ std::vector< std::string > TriggerEvent::conditionCollections( const std::string
 TriggerObjectRefVector TriggerEvent::conditionObjects( const std::string & nameCondition ) const
 {
   TriggerObjectRefVector theConditionObjects;
-  if ( const TriggerCondition * conditionPtr = condition( nameCondition ) ) {
-    for ( unsigned iObject = 0; iObject < objects()->size(); ++iObject ) {
-      if ( conditionPtr->hasObjectKey( iObject ) ) {
-        const TriggerObjectRef objectRef( objects_, iObject );
-        theConditionObjects.push_back( objectRef );
-      }
+  const unsigned iCondition( indexCondition( nameCondition ) );
+  if ( iCondition < conditions()->size() ) {
+    buildLinks();
+    for ( unsigned iK = conditionObjectOffsets_.at( iCondition ); iK < conditionObjectOffsets_.at( iCondition + 1 ); ++iK ) {
+      const TriggerObjectRef objectRef( objects_, conditionObjectKeys_.at( iK ) );
+      theConditionObjects.push_back( objectRef );
     }
   }
   return theConditionObjects;
@@ -547,10 +579,10 @@ bool TriggerEvent::objectInCondition( const TriggerObjectRef & objectRef, const
 TriggerConditionRefVector TriggerEvent::objectConditions( const TriggerObjectRef & objectRef ) const
 {
   TriggerConditionRefVector theObjectConditions;
-  for ( TriggerConditionCollection::const_iterator iCondition = conditions()->begin(); iCondition != conditions()->end(); ++iCondition ) {
-    const std::string nameCondition( iCondition->name() );
-    if ( objectInCondition( objectRef, nameCondition ) ) {
-      const TriggerConditionRef conditionRef( conditions_, indexCondition( nameCondition ) );
+  buildLinks();
+  if ( objectRef.key() < objectCollectionIds_.size() ) {
+    for ( unsigned iK = objectConditionOffsets_.at( objectRef.key() ); iK < objectConditionOffsets_.at( objectRef.key() + 1 ); ++iK ) {
+      const TriggerConditionRef conditionRef( conditions_, objectConditionKeys_.at( iK ) );
       theObjectConditions.push_back( conditionRef );
     }
   }
@@ -561,13 +593,16 @@ TriggerConditionRefVector TriggerEvent::objectConditions( const TriggerObjectRef
 // Get a vector of references to all objects, which were used in a certain algorithm given by name
 TriggerObjectRefVector TriggerEvent::algorithmObjects( const std::string & nameAlgorithm ) const
 {
-  TriggerObjectRefVector    theAlgorithmObjects;
-  TriggerConditionRefVector theConditions = algorithmConditions( nameAlgorithm );
-  for ( TriggerConditionRefVectorIterator iCondition = theConditions.begin(); iCondition != theConditions.end(); ++iCondition ) {
-    const std::string nameCondition( ( *iCondition )->name() );
-    TriggerObjectRefVector theObjects = conditionObjects( nameCondition );
-    for ( TriggerObjectRefVectorIterator iObject = theObjects.begin(); iObject != theObjects.end(); ++iObject ) {
-      theAlgorithmObjects.push_back( *iObject );
+  TriggerObjectRefVector theAlgorithmObjects;
+  if ( const TriggerAlgorithm * algorithmPtr = algorithm( nameAlgorithm ) ) {
+    buildLinks();
+    for ( unsigned iC = 0; iC < algorithmPtr->conditionKeys().size(); ++iC ) {
+      const unsigned iCondition( algorithmPtr->conditionKeys().at( iC ) );
+      if ( iCondition + 1 >= conditionObjectOffsets_.size() ) continue;
+      for ( unsigned iK = conditionObjectOffsets_.at( iCondition ); iK < conditionObjectOffsets_.at( iCondition + 1 ); ++iK ) {
+        const TriggerObjectRef objectRef( objects_, conditionObjectKeys_.at( iK ) );
+        theAlgorithmObjects.push_back( objectRef );
+      }
     }
   }
   return theAlgorithmObjects;
@@ -663,25 +698,10 @@ TriggerPathRefVector TriggerEvent::filterPaths( const TriggerFilterRef & filterR
 // Get a list of all trigger object collections used in a certain filter given by name
 std::vector< std::string > TriggerEvent::filterCollections( const std::string & labelFilter ) const
 {
-  std::vector< std::string > theFilterCollections;
-  if ( const TriggerFilter * filterPtr = filter( labelFilter ) ) {
-    for ( unsigned iObject = 0; iObject < objects()->size(); ++iObject ) {
-      if ( filterPtr->hasObjectKey( iObject ) ) {
-        bool found( false );
-        const std::string objectCollection( objects()->at( iObject ).collection() );
-        for ( std::vector< std::string >::const_iterator iC = theFilterCollections.begin(); iC != theFilterCollections.end(); ++iC ) {
-          if ( *iC == objectCollection ) {
-            found = true;
-            break;
-          }
-        }
-        if ( ! found ) {
-          theFilterCollections.push_back( objectCollection );
-        }
-      }
-    }
-  }
-  return theFilterCollections;
+  const unsigned iFilter( indexFilter( labelFilter ) );
+  if ( iFilter == filters()->size() ) return std::vector< std::string >();
+  buildLinks();
+  return linkedCollections( filterObjectKeys_.begin() + filterObjectOffsets_.at( iFilter ), filterObjectKeys_.begin() + filterObjectOffsets_.at( iFilter + 1 ) );
 }
 
 
@@ -689,12 +709,12 @@ std::vector< std::string > TriggerEvent::filterCollections( const std::string &
 TriggerObjectRefVector TriggerEvent::filterObjects( const std::string & labelFilter ) const
 {
   TriggerObjectRefVector theFilterObjects;
-  if ( const TriggerFilter * filterPtr = filter( labelFilter ) ) {
-    for ( unsigned iObject = 0; iObject < objects()->size(); ++iObject ) {
-      if ( filterPtr->hasObjectKey( iObject ) ) {
-        const TriggerObjectRef objectRef( objects_, iObject );
-        theFilterObjects.push_back( objectRef );
-      }
+  const unsigned iFilter( indexFilter( labelFilter ) );
+  if ( iFilter < filters()->size() ) {
+    buildLinks();
+    for ( unsigned iK = filterObjectOffsets_.at( iFilter ); iK < filterObjectOffsets_.at( iFilter + 1 ); ++iK ) {
+      const TriggerObjectRef objectRef( objects_, filterObjectKeys_.at( iK ) );
+      theFilterObjects.push_back( objectRef );
     }
   }
   return theFilterObjects;
@@ -712,11 +732,11 @@ bool TriggerEvent::objectInFilter( const TriggerObjectRef & objectRef, const std
 TriggerFilterRefVector TriggerEvent::objectFilters( const TriggerObjectRef & objectRef, bool firing ) const
 {
   TriggerFilterRefVector theObjectFilters;
-  for ( TriggerFilterCollection::const_iterator iFilter = filters()->begin(); iFilter != filters()->end(); ++iFilter ) {
-    const std::string labelFilter( iFilter->label() );
-    if ( objectInFilter( objectRef, labelFilter ) ) {
-      const TriggerFilterRef filterRef( filters_, indexFilter( labelFilter ) );
-      if ( ( ! firing ) || iFilter->isFiring() ) theObjectFilters.push_back( filterRef );
+  buildLinks();
+  if ( objectRef.key() < objectCollectionIds_.size() ) {
+    for ( unsigned iK = objectFilterOffsets_.at( objectRef.key() ); iK < objectFilterOffsets_.at( objectRef.key() + 1 ); ++iK ) {
+      const TriggerFilterRef filterRef( filters_, objectFilterKeys_.at( iK ) );
+      if ( ( ! firing ) || filterRef->isFiring() ) theObjectFilters.push_back( filterRef );
     }
   }
   return theObjectFilters;
@@ -728,11 +748,14 @@ TriggerObjectRefVector TriggerEvent::pathObjects( const std::string & namePath,
 {
   TriggerObjectRefVector thePathObjects;
   TriggerFilterRefVector theFilters = pathFilters( namePath, firing );
+  if ( theFilters.empty() ) return thePathObjects;
+  buildLinks();
   for ( TriggerFilterRefVectorIterator iFilter = theFilters.begin(); iFilter != theFilters.end(); ++iFilter ) {
-    const std::string labelFilter( ( *iFilter )->label() );
-    TriggerObjectRefVector theObjects = filterObjects( labelFilter );
-    for ( TriggerObjectRefVectorIterator iObject = theObjects.begin(); iObject != theObjects.end(); ++iObject ) {
-      thePathObjects.push_back( *iObject );
+    const unsigned iF( iFilter->key() );
+    if ( iF + 1 >= filterObjectOffsets_.size() ) continue;
+    for ( unsigned iK = filterObjectOffsets_.at( iF ); iK < filterObjectOffsets_.at( iF + 1 ); ++iK ) {
+      const TriggerObjectRef objectRef( objects_, filterObjectKeys_.at( iK ) );
+      thePathObjects.push_back( objectRef );
     }
   }
   return thePathObjects;
@@ -765,6 +788,42 @@ TriggerPathRefVector TriggerEvent::objectPaths( const TriggerObjectRef & objectR
 }
 
 
+// Build the reverse indices of the object x-links, if not yet done
+void TriggerEvent::buildLinks() const
+{
+  if ( linksBuilt_ ) return;
+  const unsigned nObjects( objects() ? objects()->size() : 0 );
+  // collection id table, ids in order of first appearance
+  collectionNames_.clear();
+  objectCollectionIds_.resize( nObjects );
+  std::map< std::string, unsigned > collectionIds;
+  for ( unsigned iO = 0; iO < nObjects; ++iO ) {
+    const std::pair< std::map< std::string, unsigned >::iterator, bool > inserted( collectionIds.insert( std::make_pair( objects()->at( iO ).collection(), collectionNames_.size() ) ) );
+    if ( inserted.second ) collectionNames_.push_back( inserted.first->first );
+    objectCollectionIds_.at( iO ) = inserted.first->second;
+  }
+  fillObjectLinks( conditions(), nObjects, conditionObjectOffsets_, conditionObjectKeys_, objectConditionOffsets_, objectConditionKeys_ );
+  fillObjectLinks( filters(), nObjects, filterObjectOffsets_, filterObjectKeys_, objectFilterOffsets_, objectFilterKeys_ );
+  linksBuilt_ = true;
+}
+
+
+// Get the distinct collection names of objects given by sorted keys, in order of first appearance
+std::vector< std::string > TriggerEvent::linkedCollections( std::vector< unsigned >::const_iterator begin, std::vector< unsigned >::const_iterator end ) const
+{
+  std::vector< std::string > theCollections;
+  std::vector< unsigned >    theCollectionIds;
+  for ( std::vector< unsigned >::const_iterator iKey = begin; iKey != end; ++iKey ) {
+    const unsigned collectionId( objectCollectionIds_.at( *iKey ) );
+    if ( std::find( theCollectionIds.begin(), theCollectionIds.end(), collectionId ) == theCollectionIds.end() ) {
+      theCollectionIds.push_back( collectionId );
+      theCollections.push_back( collectionNames_.at( collectionId ) );
+    }
+  }
+  return theCollections;
+}
+
+
 // Add a pat::TriggerObjectMatch association
 bool TriggerEvent::addObjectMatchResult( const TriggerObjectMatchRefProd & trigMatches, const std::string & labelMatcher )
 {
@@ -4,6 +4,7 @@
 #include "DataFormats/Common/interface/PtrVector.h"
 
 #include "DataFormats/PatCandidates/interface/TriggerObjectStandAlone.h"
+#include "DataFormats/PatCandidates/interface/PackedTriggerObjectStandAlone.h"
 #include "DataFormats/PatCandidates/interface/TriggerEvent.h"
 
 namespace {
@@ -46,6 +47,13 @@ namespace {
 //   edm::reftobase::RefVectorHolder<pat::TriggerObjectStandAloneRefVector> rvh_p_tosa;
   edm::Wrapper<pat::TriggerObjectStandAloneMatch> w_a_p_tosa;
 
+  pat::PackedTriggerObjectStandAloneCollection p_tosa;
+  edm::Wrapper<pat::PackedTriggerObjectStandAloneCollection> w_p_tosa;
+  pat::PackedTriggerObjectStandAloneTable p_tosa_t;
+  std::vector<pat::PackedTriggerObjectStandAloneTable> v_p_tosa_t;
+  pat::PackedTriggerObjectStandAloneTables p_tosa_ts;
+  edm::Wrapper<pat::PackedTriggerObjectStandAloneTables> w_p_tosa_ts;
+
   pat::TriggerFilterCollection v_p_tf;
   pat::TriggerFilterCollection::const_iterator v_p_tf_ci;
   edm::Wrapper<pat::TriggerFilterCollection> w_v_p_tf;
@@ -0,0 +1,215 @@
+#ifndef PhysicsTools_PatAlgos_PATCompiledCutSelector_h
+#define PhysicsTools_PatAlgos_PATCompiledCutSelector_h
+
+
+// -*- C++ -*-
+//
+// Package:    PatAlgos
+// Class:      PATCompiledCutSelector
+//
+/**
+  \class    pat::PATCompiledCutSelector PATCompiledCutSelector.h "PhysicsTools/PatAlgos/plugins/PATCompiledCutSelector.h"
+  \brief    String cut selector for PAT objects with an optional compiled evaluation
+
+   PATCompiledCutSelector takes the 'cut' string of the PAT object selectors. With the optional
+   configuration parameter 'compiledCut' set to 'True', cuts of the form
+     <variable> <op> <number> [ && <variable> <op> <number> ... ]
+   with <op> one of '<', '<=', '>', '>=', '==', '!=' and <variable> one of
+     pt, et, energy, mass, eta, abs(eta), phi, charge, userFloat("<label>"), userInt("<label>")
+   are evaluated directly on the object, without the reflection based expression tree.
+   Any other cut is evaluated by the StringCutObjectSelector as before, which also parses
+   (and validates) every cut in any case.
+
+  \version  $Id$
+*/
+
+
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <cmath>
+
+#include "CommonTools/Utils/interface/StringCutObjectSelector.h"
+#include "DataFormats/PatCandidates/interface/UserDataHandle.h"
+
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+
+
+namespace pat {
+
+  template< typename T >
+  class PATCompiledCutSelector {
+
+    public:
+
+      explicit PATCompiledCutSelector( const edm::ParameterSet & iConfig ) :
+        compiled_( false ),
+        fallback_( iConfig.getParameter< std::string >( "cut" ) )
+      {
+        if ( iConfig.existsAs< bool >( "compiledCut" ) && iConfig.getParameter< bool >( "compiledCut" ) ) {
+          compiled_ = compile( iConfig.getParameter< std::string >( "cut" ) );
+        }
+      }
+
+      bool operator()( const T & object ) const {
+        if ( ! compiled_ ) return fallback_( object );
+        for ( typename std::vector< Comparison >::const_iterator iC = comparisons_.begin(); iC != comparisons_.end(); ++iC ) {
+          if ( ! pass( *iC, value( *iC, object ) ) ) return false;
+        }
+        return true;
+      }
+
+      /// 'true', if the cut is evaluated without the expression tree
+      bool isCompiled() const { return compiled_; }
+
+    private:
+
+      enum Variable { Pt, Et, Energy, Mass, Eta, AbsEta, Phi, Charge, UserFloat, UserInt };
+      enum Operator { Less, LessEqual, Greater, GreaterEqual, Equal, NotEqual };
+
+      struct Comparison {
+        Comparison() : variable( Pt ), handle( "" ), op( Less ), threshold( 0. ) {}
+        Variable       variable;
+        UserDataHandle handle;
+        Operator       op;
+        double         threshold;
+      };
+
+      static std::string trim( const std::string & str ) {
+        const std::string::size_type first( str.find_first_not_of( " \t\n" ) );
+        if ( first == std::string::npos ) return std::string();
+        return str.substr( first, str.find_last_not_of( " \t\n" ) - first + 1 );
+      }
+
+      static std::string removeBlanks( const std::string & str ) {
+        std::string result;
+        for ( std::string::const_iterator iC = str.begin(); iC != str.end(); ++iC ) {
+          if ( *iC != ' ' && *iC != '\t' && *iC != '\n' ) result += *iC;
+        }
+        return result;
+      }
+
+      static bool parseNumber( const std::string & str, double & number ) {
+        if ( str.empty() ) return false;
+        char * end( 0 );
+        number = std::strtod( str.c_str(), &end );
+        return *end == '\0';
+      }
+
+      /// extracts the label from 'userFloat("label")' or 'userFloat('label')'
+      static bool parseLabel( const std::string & str, const std::string & function, std::string & label ) {
+        if ( str.size() < function.size() + 4 || str.compare( 0, function.size() + 1, function + "(" ) != 0 || str[ str.size() - 1 ] != ')' ) return false;
+        const std::string quoted( str.substr( function.size() + 1, str.size() - function.size() - 2 ) );
+        if ( ( quoted[ 0 ] != '"' && quoted[ 0 ] != '\'' ) || quoted[ quoted.size() - 1 ] != quoted[ 0 ] ) return false;
+        label = quoted.substr( 1, quoted.size() - 2 );
+        return label.find_first_of( "\"'" ) == std::string::npos;
+      }
+
+      static bool parseVariable( const std::string & str, Comparison & comparison ) {
+        const std::string name( removeBlanks( str ) );
+        std::string label;
+        if      ( name == "pt"       || name == "pt()"       ) comparison.variable = Pt;
+        else if ( name == "et"       || name == "et()"       ) comparison.variable = Et;
+        else if ( name == "energy"   || name == "energy()"   ) comparison.variable = Energy;
+        else if ( name == "mass"     || name == "mass()"     ) comparison.variable = Mass;
+        else if ( name == "eta"      || name == "eta()"      ) comparison.variable = Eta;
+        else if ( name == "abs(eta)" || name == "abs(eta())" ) comparison.variable = AbsEta;
+        else if ( name == "phi"      || name == "phi()"      ) comparison.variable = Phi;
+        else if ( name == "charge"   || name == "charge()"   ) comparison.variable = Charge;
+        else if ( parseLabel( name, "userFloat", label ) ) {
+          comparison.variable = UserFloat;
+          comparison.handle   = UserDataHandle( label );
+        }
+        else if ( parseLabel( name, "userInt", label ) ) {
+          comparison.variable = UserInt;
+          comparison.handle   = UserDataHandle( label );
+        }
+        else return false;
+        return true;
+      }
+
+      /// parses '<variable> <op> <number>' or '<number> <op> <variable>'
+      static bool parseComparison( const std::string & term, Comparison & comparison ) {
+        const std::string::size_type pos( term.find_first_of( "<>=!" ) );
+        if ( pos == std::string::npos || pos + 1 >= term.size() ) return false;
+        std::string::size_type length( 1 );
+        Operator op, mirrored;
+        const char c0( term[ pos ] );
+        const bool equal( term[ pos + 1 ] == '=' );
+        if      ( c0 == '<' ) { op = equal ? LessEqual    : Less;    mirrored = equal ? GreaterEqual : Greater; }
+        else if ( c0 == '>' ) { op = equal ? GreaterEqual : Greater; mirrored = equal ? LessEqual    : Less;    }
+        else if ( c0 == '=' && equal ) { op = Equal;    mirrored = Equal;    }
+        else if ( c0 == '!' && equal ) { op = NotEqual; mirrored = NotEqual; }
+        else return false;
+        if ( equal ) ++length;
+        const std::string lhs( trim( term.substr( 0, pos ) ) );
+        const std::string rhs( trim( term.substr( pos + length ) ) );
+        if ( parseVariable( lhs, comparison ) && parseNumber( rhs, comparison.threshold ) ) {
+          comparison.op = op;
+          return true;
+        }
+        if ( parseNumber( lhs, comparison.threshold ) && parseVariable( rhs, comparison ) ) {
+          comparison.op = mirrored;
+          return true;
+        }
+        return false;
+      }
+
+      /// 'true', if the complete cut is a conjunction of supported comparisons
+      bool compile( const std::string & cut ) {
+        comparisons_.clear();
+        std::string::size_type begin( 0 );
+        while ( true ) {
+          const std::string::size_type end( cut.find( "&&", begin ) );
+          std::string term( trim( cut.substr( begin, end == std::string::npos ? std::string::npos : end - begin ) ) );
+          if ( term.size() > 1 && term[ 0 ] == '(' && term[ term.size() - 1 ] == ')' ) term = trim( term.substr( 1, term.size() - 2 ) );
+          Comparison comparison;
+          if ( ! parseComparison( term, comparison ) ) {
+            comparisons_.clear();
+            return false;
+          }
+          comparisons_.push_back( comparison );
+          if ( end == std::string::npos ) break;
+          begin = end + 2;
+        }
+        return true;
+      }
+
+      double value( const Comparison & comparison, const T & object ) const {
+        switch ( comparison.variable ) {
+          case Pt       : return object.pt();
+          case Et       : return object.et();
+          case Energy   : return object.energy();
+          case Mass     : return object.mass();
+          case Eta      : return object.eta();
+          case AbsEta   : return std::abs( object.eta() );
+          case Phi      : return object.phi();
+          case Charge   : return object.charge();
+          case UserFloat: return object.userFloat( comparison.handle );
+          case UserInt  : return object.userInt( comparison.handle );
+        }
+        return 0.;
+      }
+
+      static bool pass( const Comparison & comparison, double value ) {
+        switch ( comparison.op ) {
+          case Less        : return value <  comparison.threshold;
+          case LessEqual   : return value <= comparison.threshold;
+          case Greater     : return value >  comparison.threshold;
+          case GreaterEqual: return value >= comparison.threshold;
+          case Equal       : return value == comparison.threshold;
+          case NotEqual    : return value != comparison.threshold;
+        }
+        return false;
+      }
+
+      bool                           compiled_;
+      std::vector< Comparison >      comparisons_;
+      StringCutObjectSelector< T >   fallback_;
+
+  };
+
+}
+
+
+#endif
@@ -0,0 +1,165 @@
+// -*- C++ -*-
+//
+// Package:    PatAlgos
+// Class:      pat::PATDeferredEmbedder
+//
+/**
+  \class    pat::PATDeferredEmbedder PATDeferredEmbedder.cc "PhysicsTools/PatAlgos/plugins/PATDeferredEmbedder.cc"
+  \brief    Embeds the referenced sub-objects into already selected PAT objects
+
+   PATDeferredEmbedder copies a PAT object collection and embeds the sub-objects (tracks, clusters,
+   PF candidates, generator particles, ...) which the PAT producer has only referenced.
+   Running the producer with its 'embed...' flags set to 'False' and this module after the object
+   selection moves the embedding to the objects which are actually written out.
+   The module takes the same 'embed...' flags as the corresponding producer; missing flags are 'False'.
+   Sub-objects, which the producer embeds only under a condition (the TeV refits of global muons), are
+   embedded here under the same condition.
+   The references have to be available at the time this module runs.
+
+  \version  $Id$
+*/
+
+
+#include <string>
+#include <vector>
+#include <utility>
+
+#include "FWCore/Framework/interface/Frameworkfwd.h"
+#include "FWCore/Framework/interface/EDProducer.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/Utilities/interface/InputTag.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "DataFormats/Common/interface/Handle.h"
+#include "DataFormats/Common/interface/View.h"
+
+#include "DataFormats/PatCandidates/interface/Electron.h"
+#include "DataFormats/PatCandidates/interface/Muon.h"
+
+
+namespace pat {
+
+  template< class PATObjectType >
+  class PATDeferredEmbedder : public edm::EDProducer {
+
+      /// embedding function of the PAT object
+      typedef void ( PATObjectType::*Embedder )();
+      /// condition for the embedding (0: always)
+      typedef bool ( *Condition )( const PATObjectType & );
+      typedef std::pair< Embedder, Condition > ConditionalEmbedder;
+      typedef std::vector< std::pair< std::string, ConditionalEmbedder > > Embedders;
+
+      edm::InputTag src_;
+      /// embedding functions switched on in the configuration
+      std::vector< ConditionalEmbedder > embedders_;
+
+    public:
+
+      explicit PATDeferredEmbedder( const edm::ParameterSet & iConfig );
+      ~PATDeferredEmbedder() {};
+
+    private:
+
+      virtual void produce( edm::Event & iEvent, const edm::EventSetup& iSetup) override;
+
+      /// all embedding functions of the PAT object by the name of their configuration flag
+      static Embedders allEmbedders();
+
+  };
+
+  typedef PATDeferredEmbedder< Electron > PATElectronDeferredEmbedder;
+  typedef PATDeferredEmbedder< Muon >     PATMuonDeferredEmbedder;
+
+}
+
+
+using namespace pat;
+
+
+namespace {
+
+  /// embedding conditions of the TeV refits as in PATMuonProducer
+  bool hasPickyMuon( const Muon & muon ) { return muon.isGlobalMuon() && muon.isAValidMuonTrack( reco::Muon::Picky ); }
+  bool hasTpfmsMuon( const Muon & muon ) { return muon.isGlobalMuon() && muon.isAValidMuonTrack( reco::Muon::TPFMS ); }
+  bool hasDytMuon( const Muon & muon )   { return muon.isGlobalMuon() && muon.isAValidMuonTrack( reco::Muon::DYT ); }
+
+}
+
+
+template<>
+PATDeferredEmbedder< Electron >::Embedders PATDeferredEmbedder< Electron >::allEmbedders()
+{
+  Embedders embedders;
+  embedders.push_back( std::make_pair( std::string( "embedGsfElectronCore" )       , ConditionalEmbedder( &Electron::embedGsfElectronCore, 0 ) ) );
+  embedders.push_back( std::make_pair( std::string( "embedGsfTrack" )              , ConditionalEmbedder( &Electron::embedGsfTrack, 0 ) ) );
+  embedders.push_back( std::make_pair( std::string( "embedSuperCluster" )          , ConditionalEmbedder( &Electron::embedSuperCluster, 0 ) ) );
+  embedders.push_back( std::make_pair( std::string( "embedPflowSuperCluster" )     , ConditionalEmbedder( &Electron::embedPflowSuperCluster, 0 ) ) );
+  embedders.push_back( std::make_pair( std::string( "embedSeedCluster" )           , ConditionalEmbedder( &Electron::embedSeedCluster, 0 ) ) );
+  embedders.push_back( std::make_pair( std::string( "embedBasicClusters" )         , ConditionalEmbedder( &Electron::embedBasicClusters, 0 ) ) );
+  embedders.push_back( std::make_pair( std::string( "embedPreshowerClusters" )     , ConditionalEmbedder( &Electron::embedPreshowerClusters, 0 ) ) );
+  embedders.push_back( std::make_pair( std::string( "embedPflowBasicClusters" )    , ConditionalEmbedder( &Electron::embedPflowBasicClusters, 0 ) ) );
+  embedders.push_back( std::make_pair( std::string( "embedPflowPreshowerClusters" ), ConditionalEmbedder( &Electron::embedPflowPreshowerClusters, 0 ) ) );
+  embedders.push_back( std::make_pair( std::string( "embedTrack" )                 , ConditionalEmbedder( &Electron::embedTrack, 0 ) ) );
+  embedders.push_back( std::make_pair( std::string( "embedPFCandidate" )           , ConditionalEmbedder( &Electron::embedPFCandidate, 0 ) ) );
+  embedders.push_back( std::make_pair( std::string( "embedGenMatch" )              , ConditionalEmbedder( Embedder( &Electron::embedGenParticle ), 0 ) ) );
+  return embedders;
+}
+
+
+template<>
+PATDeferredEmbedder< Muon >::Embedders PATDeferredEmbedder< Muon >::allEmbedders()
+{
+  Embedders embedders;
+  embedders.push_back( std::make_pair( std::string( "embedMuonBestTrack" ) , ConditionalEmbedder( &Muon::embedMuonBestTrack, 0 ) ) );
+  embedders.push_back( std::make_pair( std::string( "embedTrack" )         , ConditionalEmbedder( &Muon::embedTrack, 0 ) ) );
+  embedders.push_back( std::make_pair( std::string( "embedStandAloneMuon" ), ConditionalEmbedder( &Muon::embedStandAloneMuon, 0 ) ) );
+  embedders.push_back( std::make_pair( std::string( "embedCombinedMuon" )  , ConditionalEmbedder( &Muon::embedCombinedMuon, 0 ) ) );
+  embedders.push_back( std::make_pair( std::string( "embedPickyMuon" )     , ConditionalEmbedder( &Muon::embedPickyMuon, &hasPickyMuon ) ) );
+  embedders.push_back( std::make_pair( std::string( "embedTpfmsMuon" )     , ConditionalEmbedder( &Muon::embedTpfmsMuon, &hasTpfmsMuon ) ) );
+  embedders.push_back( std::make_pair( std::string( "embedDytMuon" )       , ConditionalEmbedder( &Muon::embedDytMuon, &hasDytMuon ) ) );
+  embedders.push_back( std::make_pair( std::string( "embedPFCandidate" )   , ConditionalEmbedder( &Muon::embedPFCandidate, 0 ) ) );
+  embedders.push_back( std::make_pair( std::string( "embedGenMatch" )      , ConditionalEmbedder( Embedder( &Muon::embedGenParticle ), 0 ) ) );
+  return embedders;
+}
+
+
+template< class PATObjectType >
+PATDeferredEmbedder< PATObjectType >::PATDeferredEmbedder( const edm::ParameterSet & iConfig ) :
+  src_( iConfig.getParameter< edm::InputTag >( "src" ) )
+{
+  const Embedders embedders( allEmbedders() );
+  for ( typename Embedders::const_iterator iEmbedder = embedders.begin(); iEmbedder != embedders.end(); ++iEmbedder ) {
+    if ( iConfig.existsAs< bool >( iEmbedder->first ) && iConfig.getParameter< bool >( iEmbedder->first ) ) embedders_.push_back( iEmbedder->second );
+  }
+  produces< std::vector< PATObjectType > >();
+}
+
+template< class PATObjectType >
+void PATDeferredEmbedder< PATObjectType >::produce( edm::Event & iEvent, const edm::EventSetup& iSetup)
+{
+  std::auto_ptr< std::vector< PATObjectType > > output( new std::vector< PATObjectType >() );
+
+  edm::Handle< edm::View< PATObjectType > > candidates;
+  iEvent.getByLabel( src_, candidates );
+  if ( ! candidates.isValid() ) {
+    edm::LogError( "missingInputSource" ) << "Input source with InputTag " << src_.encode() << " not in event.";
+    return;
+  }
+
+  output->reserve( candidates->size() );
+  for ( typename edm::View< PATObjectType >::const_iterator iCand = candidates->begin(); iCand != candidates->end(); ++iCand ) {
+    output->push_back( *iCand );
+    PATObjectType & cand( output->back() );
+    for ( typename std::vector< ConditionalEmbedder >::const_iterator iEmbedder = embedders_.begin(); iEmbedder != embedders_.end(); ++iEmbedder ) {
+      if ( iEmbedder->second == 0 || ( *iEmbedder->second )( cand ) ) ( cand.*( iEmbedder->first ) )();
+    }
+  }
+
+  iEvent.put( output );
+}
+
+
+#include "FWCore/Framework/interface/MakerMacros.h"
+
+DEFINE_FWK_MODULE( PATElectronDeferredEmbedder );
+DEFINE_FWK_MODULE( PATMuonDeferredEmbedder );
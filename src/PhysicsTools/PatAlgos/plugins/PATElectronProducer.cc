@@ -206,17 +206,23 @@ void PATElectronProducer::produce(edm::Event & iEvent, const edm::EventSetup & i
 
   IsoDepositMaps deposits(isoDepositLabels_.size());
   for (size_t j = 0, nd = deposits.size(); j < nd; ++j) {
-    iEvent.getByLabel(isoDepositLabels_[j].second, deposits[j]);
+    edm::Handle<edm::ValueMap<IsoDeposit> > map;
+    iEvent.getByLabel(isoDepositLabels_[j].second, map);
+    deposits[j].setMap(map);
   }
 
   IsolationValueMaps isolationValues(isolationValueLabels_.size());
   for (size_t j = 0; j<isolationValueLabels_.size(); ++j) {
-    iEvent.getByLabel(isolationValueLabels_[j].second, isolationValues[j]);
+    edm::Handle<edm::ValueMap<double> > map;
+    iEvent.getByLabel(isolationValueLabels_[j].second, map);
+    isolationValues[j].setMap(map);
   }
 
   IsolationValueMaps isolationValuesNoPFId(isolationValueLabelsNoPFId_.size());
   for (size_t j = 0; j<isolationValueLabelsNoPFId_.size(); ++j) {
-    iEvent.getByLabel(isolationValueLabelsNoPFId_[j].second, isolationValuesNoPFId[j]);
+    edm::Handle<edm::ValueMap<double> > map;
+    iEvent.getByLabel(isolationValueLabelsNoPFId_[j].second, map);
+    isolationValuesNoPFId[j].setMap(map);
   }
 
   // prepare the MC matching
@@ -554,7 +560,7 @@ void PATElectronProducer::produce(edm::Event & iEvent, const edm::EventSetup & i
       }
 
       for (size_t j = 0, nd = deposits.size(); j < nd; ++j) {
-        anElectron.setIsoDeposit(isoDepositLabels_[j].first, (*deposits[j])[elecsRef]);
+        anElectron.setIsoDeposit(isoDepositLabels_[j].first, deposits[j][elecsRef]);
       }
 
       // add electron ID info
@@ -774,29 +780,29 @@ void PATElectronProducer::fillElectron(Electron& anElectron,
       assert(!pfcandref.isNull());
       reco::CandidatePtr source = pfcandref->sourceCandidatePtr(0);
       anElectron.setIsoDeposit(isoDepositLabels_[j].first,
-			  (*deposits[j])[source]);
+			  deposits[j][source]);
     }
     else
       anElectron.setIsoDeposit(isoDepositLabels_[j].first,
-                          (*deposits[j])[elecRef]);
+                          deposits[j][elecRef]);
   }
 
   for (size_t j = 0; j<isolationValues.size(); ++j) {
     if(useParticleFlow_) {
       reco::CandidatePtr source = anElectron.pfCandidateRef()->sourceCandidatePtr(0);
       anElectron.setIsolation(isolationValueLabels_[j].first,
-			 (*isolationValues[j])[source]);
+			 isolationValues[j][source]);
     }
     else
       if(pfId){
-        anElectron.setIsolation(isolationValueLabels_[j].first,(*isolationValues[j])[elecRef]);
+        anElectron.setIsolation(isolationValueLabels_[j].first,isolationValues[j][elecRef]);
       }
   }
 
   //for electrons not identified as PF electrons
   for (size_t j = 0; j<isolationValuesNoPFId.size(); ++j) {
     if( !pfId) {
-      anElectron.setIsolation(isolationValueLabelsNoPFId_[j].first,(*isolationValuesNoPFId[j])[elecRef]);
+      anElectron.setIsolation(isolationValueLabelsNoPFId_[j].first,isolationValuesNoPFId[j][elecRef]);
     }
   }
 
@@ -852,17 +858,17 @@ void PATElectronProducer::fillElectron2( Electron& anElectron,
     if( isoDepositLabels_[j].first==pat::TrackIso ||
 	isoDepositLabels_[j].first==pat::EcalIso ||
 	isoDepositLabels_[j].first==pat::HcalIso ||
-	deposits[j]->contains(candPtrForGenMatch.id())) {
+	deposits[j].contains(candPtrForGenMatch.id())) {
       anElectron.setIsoDeposit(isoDepositLabels_[j].first,
- 			       (*deposits[j])[candPtrForGenMatch]);
+ 			       deposits[j][candPtrForGenMatch]);
     }
-    else if (deposits[j]->contains(candPtrForIsolation.id())) {
+    else if (deposits[j].contains(candPtrForIsolation.id())) {
       anElectron.setIsoDeposit(isoDepositLabels_[j].first,
- 			       (*deposits[j])[candPtrForIsolation]);
+ 			       deposits[j][candPtrForIsolation]);
     }
     else {
       anElectron.setIsoDeposit(isoDepositLabels_[j].first,
-			       (*deposits[j])[candPtrForIsolation->sourceCandidatePtr(0)]);
+			       deposits[j][candPtrForIsolation->sourceCandidatePtr(0)]);
     }
   }
 
@@ -870,17 +876,17 @@ void PATElectronProducer::fillElectron2( Electron& anElectron,
     if( isolationValueLabels_[j].first==pat::TrackIso ||
 	isolationValueLabels_[j].first==pat::EcalIso ||
 	isolationValueLabels_[j].first==pat::HcalIso ||
-	isolationValues[j]->contains(candPtrForGenMatch.id())) {
+	isolationValues[j].contains(candPtrForGenMatch.id())) {
       anElectron.setIsolation(isolationValueLabels_[j].first,
- 			      (*isolationValues[j])[candPtrForGenMatch]);
+ 			      isolationValues[j][candPtrForGenMatch]);
     }
-    else if (isolationValues[j]->contains(candPtrForIsolation.id())) {
+    else if (isolationValues[j].contains(candPtrForIsolation.id())) {
       anElectron.setIsolation(isolationValueLabels_[j].first,
- 			      (*isolationValues[j])[candPtrForIsolation]);
+ 			      isolationValues[j][candPtrForIsolation]);
     }
     else {
       anElectron.setIsolation(isolationValueLabels_[j].first,
-			      (*isolationValues[j])[candPtrForIsolation->sourceCandidatePtr(0)]);
+			      isolationValues[j][candPtrForIsolation->sourceCandidatePtr(0)]);
     }
   }
 }
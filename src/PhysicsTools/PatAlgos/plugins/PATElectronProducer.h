@@ -34,6 +34,7 @@
 
 #include "DataFormats/PatCandidates/interface/UserData.h"
 #include "PhysicsTools/PatAlgos/interface/PATUserDataHelper.h"
+#include "PhysicsTools/PatAlgos/plugins/PATValueMapCache.h"
 
 #include "RecoEcal/EgammaCoreTools/interface/EcalClusterLazyTools.h"
 #include "TrackingTools/TransientTrack/interface/TransientTrack.h"
@@ -101,8 +102,8 @@ namespace pat {
 
       typedef std::vector<edm::Handle<edm::Association<reco::GenParticleCollection> > > GenAssociations;
       typedef edm::RefToBase<reco::GsfElectron> ElectronBaseRef;
-      typedef std::vector< edm::Handle< edm::ValueMap<IsoDeposit> > > IsoDepositMaps;
-      typedef std::vector< edm::Handle< edm::ValueMap<double> > > IsolationValueMaps;
+      typedef std::vector< PATValueMapCache<IsoDeposit> > IsoDepositMaps;
+      typedef std::vector< PATValueMapCache<double> > IsolationValueMaps;
 
 
       /// common electron filling, for both the standard and PF2PAT case
@@ -3,6 +3,7 @@
 
 
 #include "PhysicsTools/PatAlgos/plugins/PATJetProducer.h"
+#include "PhysicsTools/PatAlgos/plugins/PATValueMapCache.h"
 
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 #include "FWCore/ParameterSet/interface/FileInPath.h"
@@ -160,12 +161,13 @@ void PATJetProducer::produce(edm::Event & iEvent, const edm::EventSetup & iSetup
 */
 
   // read in the jet correction factors ValueMap
-  std::vector<edm::ValueMap<JetCorrFactors> > jetCorrs;
+  std::vector<PATValueMapCache<JetCorrFactors> > jetCorrs;
   if (addJetCorrFactors_) {
+    jetCorrs.resize(jetCorrFactorsSrc_.size());
     for ( size_t i = 0; i < jetCorrFactorsSrc_.size(); ++i ) {
       edm::Handle<edm::ValueMap<JetCorrFactors> > jetCorr;
       iEvent.getByLabel(jetCorrFactorsSrc_[i], jetCorr);
-      jetCorrs.push_back( *jetCorr );
+      jetCorrs[i].setMap( jetCorr );
     }
   }
 
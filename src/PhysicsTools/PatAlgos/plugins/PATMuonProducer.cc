@@ -133,12 +133,16 @@ void PATMuonProducer::produce(edm::Event & iEvent, const edm::EventSetup & iSetu
 
   IsoDepositMaps deposits(isoDepositLabels_.size());
   for (size_t j = 0; j<isoDepositLabels_.size(); ++j) {
-    iEvent.getByLabel(isoDepositLabels_[j].second, deposits[j]);
+    edm::Handle<edm::ValueMap<IsoDeposit> > map;
+    iEvent.getByLabel(isoDepositLabels_[j].second, map);
+    deposits[j].setMap(map);
   }
 
   IsolationValueMaps isolationValues(isolationValueLabels_.size());
   for (size_t j = 0; j<isolationValueLabels_.size(); ++j) {
-    iEvent.getByLabel(isolationValueLabels_[j].second, isolationValues[j]);
+    edm::Handle<edm::ValueMap<double> > map;
+    iEvent.getByLabel(isolationValueLabels_[j].second, map);
+    isolationValues[j].setMap(map);
   }  
 
   // prepare the MC matching
@@ -296,7 +300,7 @@ void PATMuonProducer::produce(edm::Event & iEvent, const edm::EventSetup & iSetu
  
       //       for (size_t j = 0, nd = deposits.size(); j < nd; ++j) {
       // 	aMuon.setIsoDeposit(isoDepositLabels_[j].first, 
-      // 			    (*deposits[j])[muonRef]);
+      // 			    deposits[j][muonRef]);
       //       }
 
       // add sel to selected
@@ -403,33 +407,33 @@ void PATMuonProducer::fillMuon( Muon& aMuon, const MuonBaseRef& muonRef, const r
 
   for (size_t j = 0, nd = deposits.size(); j < nd; ++j) {
     if(useParticleFlow_) {
-      if (deposits[j]->contains(baseRef.id())) {
-	aMuon.setIsoDeposit(isoDepositLabels_[j].first, (*deposits[j])[baseRef]);
-      } else if (deposits[j]->contains(muonRef.id())){
-	aMuon.setIsoDeposit(isoDepositLabels_[j].first, (*deposits[j])[muonRef]);
+      if (deposits[j].contains(baseRef.id())) {
+	aMuon.setIsoDeposit(isoDepositLabels_[j].first, deposits[j][baseRef]);
+      } else if (deposits[j].contains(muonRef.id())){
+	aMuon.setIsoDeposit(isoDepositLabels_[j].first, deposits[j][muonRef]);
       } else {  
 	reco::CandidatePtr source = aMuon.pfCandidateRef()->sourceCandidatePtr(0); 
-	aMuon.setIsoDeposit(isoDepositLabels_[j].first, (*deposits[j])[source]);
+	aMuon.setIsoDeposit(isoDepositLabels_[j].first, deposits[j][source]);
       }
     }
     else{
-      aMuon.setIsoDeposit(isoDepositLabels_[j].first, (*deposits[j])[muonRef]);
+      aMuon.setIsoDeposit(isoDepositLabels_[j].first, deposits[j][muonRef]);
     }
   }
   
   for (size_t j = 0; j<isolationValues.size(); ++j) {
     if(useParticleFlow_) {
-      if (isolationValues[j]->contains(baseRef.id())) {
-	aMuon.setIsolation(isolationValueLabels_[j].first, (*isolationValues[j])[baseRef]);
-      } else if (isolationValues[j]->contains(muonRef.id())) {
-	aMuon.setIsolation(isolationValueLabels_[j].first, (*isolationValues[j])[muonRef]);	
+      if (isolationValues[j].contains(baseRef.id())) {
+	aMuon.setIsolation(isolationValueLabels_[j].first, isolationValues[j][baseRef]);
+      } else if (isolationValues[j].contains(muonRef.id())) {
+	aMuon.setIsolation(isolationValueLabels_[j].first, isolationValues[j][muonRef]);	
       } else {
 	reco::CandidatePtr source = aMuon.pfCandidateRef()->sourceCandidatePtr(0);      
-	aMuon.setIsolation(isolationValueLabels_[j].first, (*isolationValues[j])[source]);
+	aMuon.setIsolation(isolationValueLabels_[j].first, isolationValues[j][source]);
       }
     }
     else{
-      aMuon.setIsolation(isolationValueLabels_[j].first, (*isolationValues[j])[muonRef]);
+      aMuon.setIsolation(isolationValueLabels_[j].first, isolationValues[j][muonRef]);
     }
   }
 
@@ -32,6 +32,7 @@
 #include "DataFormats/PatCandidates/interface/UserData.h"
 #include "PhysicsTools/PatAlgos/interface/PATUserDataHelper.h"
 #include "TrackingTools/TransientTrack/interface/TransientTrackBuilder.h"
+#include "PhysicsTools/PatAlgos/plugins/PATValueMapCache.h"
 
 
 namespace pat {
@@ -56,8 +57,8 @@ namespace pat {
     /// typedefs for convenience
     typedef edm::RefToBase<reco::Muon> MuonBaseRef;
     typedef std::vector<edm::Handle<edm::Association<reco::GenParticleCollection> > > GenAssociations;
-    typedef std::vector< edm::Handle< edm::ValueMap<IsoDeposit> > > IsoDepositMaps;
-    typedef std::vector< edm::Handle< edm::ValueMap<double> > > IsolationValueMaps;
+    typedef std::vector< PATValueMapCache<IsoDeposit> > IsoDepositMaps;
+    typedef std::vector< PATValueMapCache<double> > IsolationValueMaps;
     typedef std::pair<pat::IsolationKeys,edm::InputTag> IsolationLabel;
     typedef std::vector<IsolationLabel> IsolationLabels;
 
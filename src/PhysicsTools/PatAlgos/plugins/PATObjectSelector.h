@@ -24,6 +24,7 @@
 #include "DataFormats/PatCandidates/interface/CompositeCandidate.h"
 
 #include "PhysicsTools/PatAlgos/plugins/PATJetSelector.h"
+#include "PhysicsTools/PatAlgos/plugins/PATCompiledCutSelector.h"
 
 #include <vector>
 
@@ -33,19 +34,19 @@ namespace pat {
 
   typedef SingleObjectSelector<
               std::vector<Electron>,
-              StringCutObjectSelector<Electron>
+              PATCompiledCutSelector<Electron>
           > PATElectronSelector;
   typedef SingleObjectSelector<
               std::vector<Muon>,
-              StringCutObjectSelector<Muon>
+              PATCompiledCutSelector<Muon>
           > PATMuonSelector;
   typedef SingleObjectSelector<
               std::vector<Tau>,
-              StringCutObjectSelector<Tau>
+              PATCompiledCutSelector<Tau>
           > PATTauSelector;
   typedef SingleObjectSelector<
               std::vector<Photon>,
-              StringCutObjectSelector<Photon>
+              PATCompiledCutSelector<Photon>
           > PATPhotonSelector;
   /* typedef SingleObjectSelector< */
   /*             std::vector<Jet>, */
@@ -53,11 +54,11 @@ namespace pat {
   /*         > PATJetSelector; */
   typedef SingleObjectSelector<
               std::vector<MET>,
-              StringCutObjectSelector<MET>
+              PATCompiledCutSelector<MET>
           > PATMETSelector;
   typedef SingleObjectSelector<
               std::vector<PFParticle>,
-              StringCutObjectSelector<PFParticle>
+              PATCompiledCutSelector<PFParticle>
           > PATPFParticleSelector;
   typedef SingleObjectSelector<
               std::vector<CompositeCandidate>,
@@ -69,47 +70,47 @@ namespace pat {
           > PATTriggerObjectStandAloneSelector;
   typedef SingleObjectSelector<
               std::vector<GenericParticle>,
-              StringCutObjectSelector<GenericParticle>
+              PATCompiledCutSelector<GenericParticle>
           > PATGenericParticleSelector;
 
   typedef SingleObjectSelector<
               std::vector<Electron>,
-              StringCutObjectSelector<Electron>,
+              PATCompiledCutSelector<Electron>,
               edm::RefVector<std::vector<Electron> >
           > PATElectronRefSelector;
   typedef SingleObjectSelector<
               std::vector<Muon>,
-              StringCutObjectSelector<Muon>,
+              PATCompiledCutSelector<Muon>,
               edm::RefVector<std::vector<Muon> >
           > PATMuonRefSelector;
   typedef SingleObjectSelector<
               std::vector<Tau>,
-              StringCutObjectSelector<Tau>,
+              PATCompiledCutSelector<Tau>,
               edm::RefVector<std::vector<Tau> >
           > PATTauRefSelector;
   typedef SingleObjectSelector<
               std::vector<Photon>,
-              StringCutObjectSelector<Photon>,
+              PATCompiledCutSelector<Photon>,
               edm::RefVector<std::vector<Photon> >
           > PATPhotonRefSelector;
   typedef SingleObjectSelector<
               std::vector<Jet>,
-              StringCutObjectSelector<Jet>,
+              PATCompiledCutSelector<Jet>,
               edm::RefVector<std::vector<Jet> >
           > PATJetRefSelector;
   typedef SingleObjectSelector<
               std::vector<MET>,
-              StringCutObjectSelector<MET>,
+              PATCompiledCutSelector<MET>,
               edm::RefVector<std::vector<MET> >
           > PATMETRefSelector;
   typedef SingleObjectSelector<
               std::vector<PFParticle>,
-              StringCutObjectSelector<PFParticle>,
+              PATCompiledCutSelector<PFParticle>,
               edm::RefVector<std::vector<PFParticle> >
           > PATPFParticleRefSelector;
   typedef SingleObjectSelector<
               std::vector<GenericParticle>,
-              StringCutObjectSelector<GenericParticle>,
+              PATCompiledCutSelector<GenericParticle>,
               edm::RefVector<std::vector<GenericParticle> >
           > PATGenericParticleRefSelector;
   typedef SingleObjectSelector<
@@ -3,6 +3,7 @@
 //
 
 #include "PhysicsTools/PatAlgos/plugins/PATPhotonProducer.h"
+#include "PhysicsTools/PatAlgos/plugins/PATValueMapCache.h"
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 #include "DataFormats/Common/interface/View.h"
 #include "DataFormats/HepMCCandidate/interface/GenParticleFwd.h"
@@ -122,9 +123,11 @@ void PATPhotonProducer::produce(edm::Event & iEvent, const edm::EventSetup & iSe
   if (efficiencyLoader_.enabled()) efficiencyLoader_.newEvent(iEvent);
   if (resolutionLoader_.enabled()) resolutionLoader_.newEvent(iEvent, iSetup);
   
-  std::vector<edm::Handle<edm::ValueMap<IsoDeposit> > > deposits(isoDepositLabels_.size());
+  std::vector<PATValueMapCache<IsoDeposit> > deposits(isoDepositLabels_.size());
   for (size_t j = 0, nd = deposits.size(); j < nd; ++j) {
-    iEvent.getByLabel(isoDepositLabels_[j].second, deposits[j]);
+    edm::Handle<edm::ValueMap<IsoDeposit> > map;
+    iEvent.getByLabel(isoDepositLabels_[j].second, map);
+    deposits[j].setMap(map);
   }
   
   // prepare ID extraction 
@@ -177,7 +180,7 @@ void PATPhotonProducer::produce(edm::Event & iEvent, const edm::EventSetup & iSe
     }
 
     for (size_t j = 0, nd = deposits.size(); j < nd; ++j) {
-        aPhoton.setIsoDeposit(isoDepositLabels_[j].first, (*deposits[j])[photonRef]);
+        aPhoton.setIsoDeposit(isoDepositLabels_[j].first, deposits[j][photonRef]);
     }
 
 
@@ -3,6 +3,7 @@
 //
 
 #include "PhysicsTools/PatAlgos/plugins/PATTauProducer.h"
+#include "PhysicsTools/PatAlgos/plugins/PATValueMapCache.h"
 
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 #include "FWCore/ParameterSet/interface/FileInPath.h"
@@ -160,9 +161,11 @@ void PATTauProducer::produce(edm::Event & iEvent, const edm::EventSetup & iSetup
   if (efficiencyLoader_.enabled()) efficiencyLoader_.newEvent(iEvent);
   if (resolutionLoader_.enabled()) resolutionLoader_.newEvent(iEvent, iSetup);
    
-  std::vector<edm::Handle<edm::ValueMap<IsoDeposit> > > deposits(isoDepositLabels_.size());
+  std::vector<PATValueMapCache<IsoDeposit> > deposits(isoDepositLabels_.size());
   for (size_t j = 0, nd = deposits.size(); j < nd; ++j) {
-    iEvent.getByLabel(isoDepositLabels_[j].second, deposits[j]);
+    edm::Handle<edm::ValueMap<IsoDeposit> > map;
+    iEvent.getByLabel(isoDepositLabels_[j].second, map);
+    deposits[j].setMap(map);
   }
 
   // prepare the MC matching
@@ -369,7 +372,7 @@ void PATTauProducer::produce(edm::Event & iEvent, const edm::EventSetup & iSetup
     }
     
     for (size_t j = 0, nd = deposits.size(); j < nd; ++j) {
-      aTau.setIsoDeposit(isoDepositLabels_[j].first, (*deposits[j])[tausRef]);
+      aTau.setIsoDeposit(isoDepositLabels_[j].first, deposits[j][tausRef]);
     }
 
     if (efficiencyLoader_.enabled()) {
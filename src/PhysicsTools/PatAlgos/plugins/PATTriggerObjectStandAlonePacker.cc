@@ -0,0 +1,92 @@
+// -*- C++ -*-
+//
+// Package:    PatAlgos
+// Class:      pat::PATTriggerObjectStandAlonePacker
+//
+/**
+  \class    pat::PATTriggerObjectStandAlonePacker PATTriggerObjectStandAlonePacker.cc "PhysicsTools/PatAlgos/plugins/PATTriggerObjectStandAlonePacker.cc"
+  \brief    Packs a pat::TriggerObjectStandAloneCollection for compact output
+
+   PATTriggerObjectStandAlonePacker reads the stand-alone trigger objects produced by the
+   PATTriggerProducer and writes them as pat::PackedTriggerObjectStandAloneCollection.
+   The names used by the objects are collected in one pat::PackedTriggerObjectStandAloneTable per run,
+   which is written at the end of the run as pat::PackedTriggerObjectStandAloneTables run product.
+   The PATTriggerObjectStandAloneUnpacker restores the pat::TriggerObjectStandAloneCollection.
+
+  \version  $Id$
+*/
+
+
+#include "FWCore/Framework/interface/Frameworkfwd.h"
+#include "FWCore/Framework/interface/one/EDProducer.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/Run.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/Utilities/interface/InputTag.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "DataFormats/Common/interface/Handle.h"
+
+#include "DataFormats/PatCandidates/interface/PackedTriggerObjectStandAlone.h"
+
+#include <memory>
+
+
+namespace pat {
+
+  class PATTriggerObjectStandAlonePacker : public edm::one::EDProducer< edm::EndRunProducer > {
+
+      edm::InputTag src_;
+      /// name table of the current run, started with its first event
+      std::auto_ptr< PackedTriggerObjectStandAloneTable > table_;
+
+    public:
+
+      explicit PATTriggerObjectStandAlonePacker( const edm::ParameterSet & iConfig );
+      ~PATTriggerObjectStandAlonePacker() {};
+
+    private:
+
+      virtual void produce( edm::Event & iEvent, const edm::EventSetup& iSetup) override;
+      virtual void endRunProduce( edm::Run & iRun, const edm::EventSetup& iSetup) override;
+
+  };
+
+}
+
+
+using namespace pat;
+
+
+PATTriggerObjectStandAlonePacker::PATTriggerObjectStandAlonePacker( const edm::ParameterSet & iConfig ) :
+  src_( iConfig.getParameter< edm::InputTag >( "src" ) )
+{
+  produces< PackedTriggerObjectStandAloneCollection >();
+  produces< PackedTriggerObjectStandAloneTables, edm::InRun >();
+}
+
+void PATTriggerObjectStandAlonePacker::produce( edm::Event & iEvent, const edm::EventSetup& iSetup)
+{
+  edm::Handle< TriggerObjectStandAloneCollection > triggerObjects;
+  iEvent.getByLabel( src_, triggerObjects );
+  if ( ! triggerObjects.isValid() ) {
+    edm::LogError( "missingInputSource" ) << "Input source with InputTag " << src_.encode() << " not in event.";
+    return;
+  }
+
+  if ( table_.get() == 0 ) table_.reset( new PackedTriggerObjectStandAloneTable( iEvent.luminosityBlock(), iEvent.id().event() ) );
+  std::auto_ptr< PackedTriggerObjectStandAloneCollection > output( new PackedTriggerObjectStandAloneCollection( *triggerObjects, *table_ ) );
+  iEvent.put( output );
+}
+
+void PATTriggerObjectStandAlonePacker::endRunProduce( edm::Run & iRun, const edm::EventSetup& iSetup)
+{
+  std::auto_ptr< PackedTriggerObjectStandAloneTables > output( new PackedTriggerObjectStandAloneTables() );
+  if ( table_.get() != 0 ) output->add( *table_ );
+  iRun.put( output );
+  table_.reset();
+}
+
+
+#include "FWCore/Framework/interface/MakerMacros.h"
+
+DEFINE_FWK_MODULE( PATTriggerObjectStandAlonePacker );
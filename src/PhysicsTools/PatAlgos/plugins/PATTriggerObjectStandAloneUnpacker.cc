@@ -0,0 +1,92 @@
+// -*- C++ -*-
+//
+// Package:    PatAlgos
+// Class:      pat::PATTriggerObjectStandAloneUnpacker
+//
+/**
+  \class    pat::PATTriggerObjectStandAloneUnpacker PATTriggerObjectStandAloneUnpacker.cc "PhysicsTools/PatAlgos/plugins/PATTriggerObjectStandAloneUnpacker.cc"
+  \brief    Restores a pat::TriggerObjectStandAloneCollection from its packed representation
+
+   PATTriggerObjectStandAloneUnpacker reads a pat::PackedTriggerObjectStandAloneCollection written by
+   the PATTriggerObjectStandAlonePacker together with the pat::PackedTriggerObjectStandAloneTables of
+   its run and produces the pat::TriggerObjectStandAloneCollection.
+   The run product is written at the end of the run, so the unpacking has to run in a later job
+   than the packing.
+   The unpacked collection is a new product: matches and pat::TriggerEvent references to the
+   original PATTriggerProducer output do not point to it, so the PAT trigger matching (and
+   embedding) has to be rerun on the unpacked objects.
+
+  \version  $Id$
+*/
+
+
+#include "FWCore/Framework/interface/Frameworkfwd.h"
+#include "FWCore/Framework/interface/EDProducer.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/Run.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/Utilities/interface/InputTag.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "DataFormats/Common/interface/Handle.h"
+
+#include "DataFormats/PatCandidates/interface/PackedTriggerObjectStandAlone.h"
+
+
+namespace pat {
+
+  class PATTriggerObjectStandAloneUnpacker : public edm::EDProducer {
+
+      edm::InputTag src_;
+
+    public:
+
+      explicit PATTriggerObjectStandAloneUnpacker( const edm::ParameterSet & iConfig );
+      ~PATTriggerObjectStandAloneUnpacker() {};
+
+    private:
+
+      virtual void produce( edm::Event & iEvent, const edm::EventSetup& iSetup) override;
+
+  };
+
+}
+
+
+using namespace pat;
+
+
+PATTriggerObjectStandAloneUnpacker::PATTriggerObjectStandAloneUnpacker( const edm::ParameterSet & iConfig ) :
+  src_( iConfig.getParameter< edm::InputTag >( "src" ) )
+{
+  produces< TriggerObjectStandAloneCollection >();
+}
+
+void PATTriggerObjectStandAloneUnpacker::produce( edm::Event & iEvent, const edm::EventSetup& iSetup)
+{
+  edm::Handle< PackedTriggerObjectStandAloneCollection > packedTriggerObjects;
+  iEvent.getByLabel( src_, packedTriggerObjects );
+  if ( ! packedTriggerObjects.isValid() ) {
+    edm::LogError( "missingInputSource" ) << "Input source with InputTag " << src_.encode() << " not in event.";
+    return;
+  }
+
+  edm::Handle< PackedTriggerObjectStandAloneTables > packedTriggerTables;
+  iEvent.getRun().getByLabel( src_, packedTriggerTables );
+  if ( ! packedTriggerTables.isValid() ) {
+    edm::LogError( "missingInputSource" ) << "Input source with InputTag " << src_.encode() << " not in run.";
+    return;
+  }
+  const PackedTriggerObjectStandAloneTable * table( packedTriggerObjects->table( *packedTriggerTables ) );
+  if ( table == 0 ) {
+    edm::LogError( "missingInputSource" ) << "Name table of " << src_.encode() << " for luminosity block " << packedTriggerObjects->tableLuminosityBlock() << ", event " << packedTriggerObjects->tableEvent() << " not in run.";
+    return;
+  }
+
+  std::auto_ptr< TriggerObjectStandAloneCollection > output( new TriggerObjectStandAloneCollection( packedTriggerObjects->unpack( *table ) ) );
+  iEvent.put( output );
+}
+
+
+#include "FWCore/Framework/interface/MakerMacros.h"
+
+DEFINE_FWK_MODULE( PATTriggerObjectStandAloneUnpacker );
@@ -10,6 +10,11 @@
 #include <utility>
 #include <cassert>
 #include <string>
+#include <algorithm>
+
+#include <boost/ptr_container/ptr_vector.hpp>
+#include "tbb/parallel_for.h"
+#include "tbb/blocked_range.h"
 
 #include "CondFormats/L1TObjects/interface/L1GtTriggerMenu.h"
 #include "CondFormats/DataRecord/interface/L1GtTriggerMenuRcd.h"
@@ -42,6 +47,146 @@ const unsigned L1GlobalTriggerReadoutSetup::NumberPhysTriggersExtended;
 const unsigned L1GlobalTriggerReadoutSetup::NumberTechnicalTriggers;
 static const bool useL1EventSetup( true );
 static const bool useL1GtTriggerMenuLite( false );
+static const int  moduleStateUnknown( -2 ); // module state not (yet) determined in this event
+
+
+namespace {
+
+  /// reserves at least 'size' elements, returns 'true', if the storage had to grow
+  template< class T >
+  bool reserveArena( std::vector< T > & vec, size_t size )
+  {
+    if ( size <= vec.capacity() ) return false;
+    vec.reserve( size );
+    return true;
+  }
+
+  /// Conversion of one l1extra collection into a contiguous range of the PAT trigger object collections
+  class L1ExtraConversion {
+
+    public:
+
+      L1ExtraConversion( const InputTag & tag, trigger::TriggerObjectType triggerObjectType, L1GtObject l1GtObject ) :
+        collection_( tag.encode() ),
+        triggerObjectType_( triggerObjectType ),
+        l1GtObject_( l1GtObject ),
+        offset_( 0 )
+      {}
+      virtual ~L1ExtraConversion() {}
+
+      /// number of objects to convert
+      size_t size() const { return indices_.size(); }
+      /// L1 object type of the collection
+      L1GtObject l1GtObject() const { return l1GtObject_; }
+      /// position of the first converted object relative to the first L1 object in the output
+      void setOffset( size_t offset ) { offset_ = offset; }
+      /// keys of the converted objects from the main bunch crossing,
+      /// given the key of the first L1 object in the stand-alone collection
+      std::vector< unsigned > keys( size_t firstKey ) const {
+        std::vector< unsigned > keys;
+        keys.reserve( mainBxPositions_.size() );
+        for ( std::vector< size_t >::const_iterator iP = mainBxPositions_.begin(); iP != mainBxPositions_.end(); ++iP ) keys.push_back( firstKey + offset_ + *iP );
+        return keys;
+      }
+      /// fills the pre-sized output ranges, starting at the first L1 object;
+      /// 'objects' may be 0 in stand-alone mode
+      void convert( bool saveL1Refs, TriggerObject * objects, TriggerObjectStandAlone * objectsStandAlone ) const {
+        for ( size_t iO = 0; iO < indices_.size(); ++iO ) {
+          TriggerObject triggerObject( makeTriggerObject( indices_[ iO ], saveL1Refs ) );
+          triggerObject.setCollection( collection_ );
+          triggerObject.addTriggerObjectType( triggerObjectType_ );
+          if ( objects ) objects[ offset_ + iO ] = triggerObject;
+          objectsStandAlone[ offset_ + iO ] = TriggerObjectStandAlone( triggerObject );
+        }
+      }
+
+    protected:
+
+      /// trigger object from the l1extra particle with index 'index'
+      virtual TriggerObject makeTriggerObject( size_t index, bool saveL1Refs ) const = 0;
+
+      std::vector< size_t > indices_;         // indices of the selected l1extra particles
+      std::vector< size_t > mainBxPositions_; // positions in 'indices_' of particles from the main bunch crossing
+
+    private:
+
+      std::string                collection_;
+      trigger::TriggerObjectType triggerObjectType_;
+      L1GtObject                 l1GtObject_;
+      size_t                     offset_;
+
+  };
+
+  template< class L1ExtraCollection >
+  class L1ExtraConverter : public L1ExtraConversion {
+
+    public:
+
+      L1ExtraConverter( const Handle< L1ExtraCollection > & handle, const InputTag & tag, trigger::TriggerObjectType triggerObjectType, L1GtObject l1GtObject, bool mainBxOnly ) :
+        L1ExtraConversion( tag, triggerObjectType, l1GtObject ),
+        handle_( handle )
+      {
+        indices_.reserve( handle_->size() );
+        for ( size_t iP = 0; iP < handle_->size(); ++iP ) {
+          const bool mainBx( ( *handle_ )[ iP ].bx() == 0 );
+          if ( mainBxOnly && ! mainBx ) continue;
+          if ( mainBx ) mainBxPositions_.push_back( indices_.size() );
+          indices_.push_back( iP );
+        }
+      }
+
+    private:
+
+      virtual TriggerObject makeTriggerObject( size_t index, bool saveL1Refs ) const {
+        if ( saveL1Refs ) {
+          const reco::CandidateBaseRef leafCandRef( Ref< L1ExtraCollection >( handle_, index ) );
+          return TriggerObject( leafCandRef );
+        }
+        return TriggerObject( reco::LeafCandidate( ( *handle_ )[ index ] ) );
+      }
+
+      Handle< L1ExtraCollection > handle_;
+
+  };
+
+  /// adds the conversion of an l1extra collection, if configured and available
+  template< class L1ExtraCollection >
+  void addL1ExtraConversion( const Event & iEvent, const InputTag & tag, const std::string & typeName, trigger::TriggerObjectType triggerObjectType, L1GtObject l1GtObject, bool mainBxOnly,
+                             boost::ptr_vector< L1ExtraConversion > & conversions )
+  {
+    if ( tag.label().empty() ) return;
+    Handle< L1ExtraCollection > handle;
+    iEvent.getByLabel( tag, handle );
+    if ( handle.isValid() ) conversions.push_back( new L1ExtraConverter< L1ExtraCollection >( handle, tag, triggerObjectType, l1GtObject, mainBxOnly ) );
+    else LogError( "l1ExtraValid" ) << typeName << " product with InputTag '" << tag.encode() << "' not in event";
+  }
+
+  /// loop body over the l1extra conversions, also used for the concurrent processing
+  class L1ExtraConversionBody {
+
+    public:
+
+      L1ExtraConversionBody( const boost::ptr_vector< L1ExtraConversion > & conversions, bool saveL1Refs, TriggerObject * objects, TriggerObjectStandAlone * objectsStandAlone ) :
+        conversions_( conversions ),
+        saveL1Refs_( saveL1Refs ),
+        objects_( objects ),
+        objectsStandAlone_( objectsStandAlone )
+      {}
+
+      void operator()( const tbb::blocked_range< size_t > & range ) const {
+        for ( size_t iC = range.begin(); iC != range.end(); ++iC ) conversions_[ iC ].convert( saveL1Refs_, objects_, objectsStandAlone_ );
+      }
+
+    private:
+
+      const boost::ptr_vector< L1ExtraConversion > & conversions_;
+      bool                                           saveL1Refs_;
+      TriggerObject *                                objects_;
+      TriggerObjectStandAlone *                      objectsStandAlone_;
+
+  };
+
+}
 
 
 PATTriggerProducer::PATTriggerProducer( const ParameterSet & iConfig ) :
@@ -70,6 +215,8 @@ PATTriggerProducer::PATTriggerProducer( const ParameterSet & iConfig ) :
   autoProcessNameL1ExtraHTM_( false ),
   mainBxOnly_( true ),
   saveL1Refs_( false ),
+  l1ExtraConcurrent_( false ),
+  l1GtTriggerMenuCacheId_( 0 ),
   // HLTConfigProvider
   hltConfigInit_( false ),
   // HLT configuration parameters
@@ -143,6 +290,7 @@ PATTriggerProducer::PATTriggerProducer( const ParameterSet & iConfig ) :
   }
   if ( iConfig.exists( "mainBxOnly" ) ) mainBxOnly_ = iConfig.getParameter< bool >( "mainBxOnly" );
   if ( iConfig.exists( "saveL1Refs" ) ) saveL1Refs_ = iConfig.getParameter< bool >( "saveL1Refs" );
+  if ( iConfig.exists( "l1ExtraConcurrent" ) ) l1ExtraConcurrent_ = iConfig.getParameter< bool >( "l1ExtraConcurrent" );
 
   // HLT configuration parameters
   if ( iConfig.exists( "triggerResults" ) )      tagTriggerResults_     = iConfig.getParameter< InputTag >( "triggerResults" );
@@ -229,6 +377,8 @@ void PATTriggerProducer::beginRun(const Run & iRun, const EventSetup & iSetup )
 
   // Update mapping from filter names to path names
   if (hltConfigInit_ && changed) moduleLabelToPathAndFlags_.init( hltConfig_ );
+  // Module names kept in the event arena belong to the previous HLT menu
+  if ( changed ) arena_.moduleStates.clear();
 
   // Extract pre-scales
   if ( hltConfigInit_ ) {
@@ -356,7 +506,10 @@ void PATTriggerProducer::produce( Event& iEvent, const EventSetup& iSetup )
     const unsigned sizeFilters( handleTriggerEvent->sizeFilters() );
     const unsigned sizeObjects( handleTriggerEvent->sizeObjects() );
 
-    std::map< std::string, int > moduleStates;
+    // module states are kept per module name for the whole HLT menu and only reset here
+    std::map< std::string, int > & moduleStates( arena_.moduleStates );
+    const size_t sizeModuleStates( moduleStates.size() );
+    for ( std::map< std::string, int >::iterator iS = moduleStates.begin(); iS != moduleStates.end(); ++iS ) iS->second = moduleStateUnknown;
 
     if ( ! onlyStandAlone_ ) {
       std::auto_ptr< TriggerPathCollection > triggerPaths( new TriggerPathCollection() );
@@ -379,9 +532,11 @@ void PATTriggerProducer::produce( Event& iEvent, const EventSetup& iSetup )
         // add module names to path and states' map
         const unsigned sizeModulesPath( hltConfig_.size( indexPath ) );
         assert( indexLastFilterPathModules < sizeModulesPath );
-        std::map< unsigned, std::string > indicesModules;
+        std::vector< std::pair< unsigned, const std::string * > > & indicesModules( arena_.indicesModules );
+        indicesModules.clear();
+        if ( reserveArena( indicesModules, sizeModulesPath ) ) ++arena_.nScratchGrowths;
         for ( size_t iM = 0; iM < sizeModulesPath; ++iM ) {
-          const std::string nameModule( hltConfig_.moduleLabel( indexPath, iM ) );
+          const std::string & nameModule( hltConfig_.moduleLabel( indexPath, iM ) );
           if ( addPathModuleLabels_ ) {
             triggerPath.addModule( nameModule );
           }
@@ -390,8 +545,9 @@ void PATTriggerProducer::produce( Event& iEvent, const EventSetup& iSetup )
             triggerPath.addFilterIndex( indexFilter );
           }
           const unsigned slotModule( hltConfig_.moduleIndex( indexPath, nameModule ) );
-          indicesModules.insert( std::pair< unsigned, std::string >( slotModule, nameModule ) );
+          indicesModules.push_back( std::make_pair( slotModule, &nameModule ) );
         }
+        std::sort( indicesModules.begin(), indicesModules.end() );
         // add L1 seeds
         const L1SeedCollection l1Seeds( hltConfig_.hltL1GTSeeds( namePath ) );
         for ( L1SeedCollection::const_iterator iSeed = l1Seeds.begin(); iSeed != l1Seeds.end(); ++iSeed ) {
@@ -400,13 +556,14 @@ void PATTriggerProducer::produce( Event& iEvent, const EventSetup& iSetup )
         // store path
         triggerPaths->push_back( triggerPath );
         // cache module states to be used for the filters
-        for ( std::map< unsigned, std::string >::const_iterator iM = indicesModules.begin(); iM != indicesModules.end(); ++iM ) {
+        for ( std::vector< std::pair< unsigned, const std::string * > >::const_iterator iM = indicesModules.begin(); iM != indicesModules.end(); ++iM ) {
           if ( iM->first < indexLastFilterPathModules ) {
-            moduleStates[ iM->second ] = 1;
+            moduleStates[ *( iM->second ) ] = 1;
           } else if ( iM->first == indexLastFilterPathModules ) {
-            moduleStates[ iM->second ] = handleTriggerResults->accept( indexPath );
-          } else if ( moduleStates.find( iM->second ) == moduleStates.end() ) {
-            moduleStates[ iM->second ] = -1;
+            moduleStates[ *( iM->second ) ] = handleTriggerResults->accept( indexPath );
+          } else {
+            int & moduleState( moduleStates.insert( std::make_pair( *( iM->second ), moduleStateUnknown ) ).first->second );
+            if ( moduleState == moduleStateUnknown ) moduleState = -1;
           }
         }
       }
@@ -417,38 +574,59 @@ void PATTriggerProducer::produce( Event& iEvent, const EventSetup& iSetup )
     // Store used trigger objects and their types for HLT filters
     // (only active filter(s) available from trigger::TriggerEvent)
 
-    std::multimap< trigger::size_type, int >         objectTypes;
-    std::multimap< trigger::size_type, std::string > filterLabels;
+    std::vector< std::string > & filterLabels( arena_.filterLabels );
+    std::vector< const std::vector< ModuleLabelToPathAndFlags::PathAndFlags > * > & filterPaths( arena_.filterPaths );
+    std::vector< FilterObject > & filterObjects( arena_.filterObjects );
+    if ( filterLabels.size() < sizeFilters ) {
+      ++arena_.nScratchGrowths;
+      filterLabels.resize( sizeFilters );
+    }
+    filterPaths.resize( sizeFilters );
+    filterObjects.clear();
+    size_t sizeFilterObjects( 0 );
+    for ( size_t iF = 0; iF < sizeFilters; ++iF ) sizeFilterObjects += handleTriggerEvent->filterKeys( iF ).size();
+    if ( reserveArena( filterObjects, sizeFilterObjects ) ) ++arena_.nScratchGrowths;
 
     for ( size_t iF = 0; iF < sizeFilters; ++iF ) {
+      // keep the label of the previous event, if it is the same, so that its storage is reused
       const std::string nameFilter( handleTriggerEvent->filterLabel( iF ) );
+      if ( filterLabels[ iF ] != nameFilter ) filterLabels[ iF ] = nameFilter;
+      filterPaths[ iF ] = &( moduleLabelToPathAndFlags_[ filterLabels[ iF ] ] );
       const trigger::Keys & keys  = handleTriggerEvent->filterKeys( iF );
       const trigger::Vids & types = handleTriggerEvent->filterIds( iF );
       assert( types.size() == keys.size() );
       for ( size_t iK = 0; iK < keys.size(); ++iK ) {
-        filterLabels.insert( std::pair< trigger::size_type, std::string >( keys[ iK ], nameFilter ) );
-        objectTypes.insert( std::pair< trigger::size_type, int >( keys[ iK ], types[ iK ] ) );
+        filterObjects.push_back( FilterObject( keys[ iK ], iF, types[ iK ] ) );
       }
     }
+    // same order as in a multimap by object key
+    std::stable_sort( filterObjects.begin(), filterObjects.end() );
 
     // HLT objects
 
-    triggerObjects->reserve( onlyStandAlone_ ? 0 : sizeObjects );
-    triggerObjectsStandAlone->reserve( sizeObjects );
+    // include the L1 objects of the largest event so far
+    triggerObjects->reserve( onlyStandAlone_ ? 0 : sizeObjects + arena_.maxSizeL1Objects );
+    triggerObjectsStandAlone->reserve( sizeObjects + arena_.maxSizeL1Objects );
 
     const trigger::Keys & collectionKeys( handleTriggerEvent->collectionKeys() );
-    std::map< trigger::size_type, trigger::size_type > newObjectKeys;
+    // new keys by HLT object key, 'sizeObjects' for excluded objects and 'sizeObjects + 1' for unknown ones
+    std::vector< unsigned > & newObjectKeys( arena_.newObjectKeys );
+    if ( reserveArena( newObjectKeys, sizeObjects ) ) ++arena_.nScratchGrowths;
+    newObjectKeys.assign( sizeObjects, sizeObjects + 1 );
+    std::vector< FilterObject >::const_iterator iFilterObject( filterObjects.begin() );
     for ( size_t iO = 0, iC = 0, nC = handleTriggerEvent->sizeCollections(); iO < sizeObjects && iC < nC; ++iO ) {
       const trigger::TriggerObject tobj = handleTriggerEvent->getObjects().at( iO );
       TriggerObject triggerObject( reco::Particle::PolarLorentzVector(tobj.pt(), tobj.eta(), tobj.phi(), tobj.mass()), tobj.id()  );
       // set collection
       while ( iO >= collectionKeys[ iC ] ) ++iC; // relies on well ordering of trigger objects with respect to the collections
       triggerObject.setCollection( handleTriggerEvent->collectionTagEncoded( iC ) );
+      // filters of this object
+      while ( iFilterObject != filterObjects.end() && iFilterObject->key < iO ) ++iFilterObject;
+      std::vector< FilterObject >::const_iterator iFilterObjectEnd( iFilterObject );
+      while ( iFilterObjectEnd != filterObjects.end() && iFilterObjectEnd->key == iO ) ++iFilterObjectEnd;
       // set filter ID
-      typedef std::multimap< trigger::size_type, int >::const_iterator it_type;
-      for (std::pair<it_type,it_type> trange = objectTypes.equal_range(iO);
-          trange.first != trange.second; ++trange.first) {
-          triggerObject.addTriggerObjectType( trange.first->second );
+      for ( std::vector< FilterObject >::const_iterator iFO = iFilterObject; iFO != iFilterObjectEnd; ++iFO ) {
+          triggerObject.addTriggerObjectType( iFO->type );
       }
 
       // stand-alone trigger object
@@ -457,16 +635,15 @@ void PATTriggerProducer::produce( Event& iEvent, const EventSetup& iSetup )
       bool excluded( false );
       for ( size_t iE = 0; iE < exludeCollections_.size(); ++iE ) {
         if ( triggerObjectStandAlone.hasCollection( exludeCollections_.at( iE ) ) ) {
-          if ( ! onlyStandAlone_ ) newObjectKeys[ iO ] = trigger::size_type( sizeObjects );
+          if ( ! onlyStandAlone_ ) newObjectKeys[ iO ] = sizeObjects;
           excluded = true;
           break;
         }
       }
       if ( excluded ) continue;
-      typedef std::multimap< trigger::size_type, std::string >::const_iterator it_fl;
-      for (std::pair<it_fl,it_fl> frange = filterLabels.equal_range(iO); frange.first != frange.second; ++frange.first) {
-          triggerObjectStandAlone.addFilterLabel( frange.first->second );
-          const std::vector<ModuleLabelToPathAndFlags::PathAndFlags> & paths = moduleLabelToPathAndFlags_[frange.first->second];
+      for ( std::vector< FilterObject >::const_iterator iFO = iFilterObject; iFO != iFilterObjectEnd; ++iFO ) {
+          triggerObjectStandAlone.addFilterLabel( filterLabels[ iFO->filterIndex ] );
+          const std::vector<ModuleLabelToPathAndFlags::PathAndFlags> & paths = *( filterPaths[ iFO->filterIndex ] );
           for (std::vector<ModuleLabelToPathAndFlags::PathAndFlags>::const_iterator iP = paths.begin(); iP != paths.end(); ++iP) {
               bool pathFired = handleTriggerResults->wasrun( iP->pathIndex ) && handleTriggerResults->accept( iP->pathIndex );
               triggerObjectStandAlone.addPathName( iP->pathName, pathFired && iP->lastFilter, pathFired && iP->l3Filter );
@@ -476,7 +653,7 @@ void PATTriggerProducer::produce( Event& iEvent, const EventSetup& iSetup )
       triggerObjectsStandAlone->push_back( triggerObjectStandAlone );
       if ( ! onlyStandAlone_ ) {
         triggerObjects->push_back( triggerObject );
-        newObjectKeys[ iO ] = trigger::size_type( triggerObjects->size() - 1 );
+        newObjectKeys[ iO ] = triggerObjects->size() - 1;
       }
     }
 
@@ -496,7 +673,7 @@ void PATTriggerProducer::produce( Event& iEvent, const EventSetup& iSetup )
         // set keys and trigger object types of used objects
         for ( size_t iK = 0; iK < keys.size(); ++iK ) { // identical to types.size()
           // check, if current object is excluded
-          if ( newObjectKeys.find( keys.at( iK ) ) != newObjectKeys.end() ) {
+          if ( keys.at( iK ) < sizeObjects && newObjectKeys[ keys.at( iK ) ] <= sizeObjects ) {
             if ( newObjectKeys[ keys.at( iK ) ] == sizeObjects ) continue;
             triggerFilter.addObjectKey( newObjectKeys[ keys.at( iK ) ] );
             triggerFilter.addTriggerObjectType( types.at( iK ) );
@@ -507,7 +684,7 @@ void PATTriggerProducer::produce( Event& iEvent, const EventSetup& iSetup )
         }
         // set status from path info
         std::map< std::string, int >::iterator iS( moduleStates.find( nameFilter ) );
-        if ( iS != moduleStates.end() ) {
+        if ( iS != moduleStates.end() && iS->second != moduleStateUnknown ) {
           if ( ! triggerFilter.setStatus( iS->second ) ) {
             triggerFilter.setStatus( -1 ); // FIXME different code for "unvalid status determined" needed?
           }
@@ -520,6 +697,7 @@ void PATTriggerProducer::produce( Event& iEvent, const EventSetup& iSetup )
       // put HLT filters to event
       iEvent.put( triggerFilters );
     }
+    arena_.nModuleStateNodes += moduleStates.size() - sizeModuleStates;
 
   } // if ( goodHlt )
 
@@ -528,205 +706,36 @@ void PATTriggerProducer::produce( Event& iEvent, const EventSetup& iSetup )
 
   // map for assignments of objects to conditions
   std::map< L1GtObject, std::vector< unsigned > > l1ObjectTypeMap;
-  if ( ! tagL1ExtraMu_.label().empty() ) {
-    Handle< l1extra::L1MuonParticleCollection > handleL1ExtraMu;
-    iEvent.getByLabel( tagL1ExtraMu_, handleL1ExtraMu );
-    if ( handleL1ExtraMu.isValid() ) {
-      std::vector< unsigned > muKeys;
-      for ( size_t l1Mu = 0; l1Mu < handleL1ExtraMu->size(); ++l1Mu ) {
-        if ( mainBxOnly_ && handleL1ExtraMu->at( l1Mu ).bx() != 0 ) continue;
-        TriggerObject triggerObject;
-        if ( saveL1Refs_ ) {
-          const reco::CandidateBaseRef leafCandRef( l1extra::L1MuonParticleRef( handleL1ExtraMu, l1Mu ) );
-          triggerObject = TriggerObject( leafCandRef );
-        } else {
-          const reco::LeafCandidate leafCandidate( *( handleL1ExtraMu->at( l1Mu ).reco::LeafCandidate::clone() ) );
-          triggerObject = TriggerObject( leafCandidate );
-        }
-        triggerObject.setCollection( tagL1ExtraMu_ );
-        triggerObject.addTriggerObjectType( trigger::TriggerL1Mu );
-        if ( ! onlyStandAlone_ ) triggerObjects->push_back( triggerObject );
-        TriggerObjectStandAlone triggerObjectStandAlone( triggerObject );
-        triggerObjectsStandAlone->push_back( triggerObjectStandAlone );
-        if ( handleL1ExtraMu->at( l1Mu ).bx() == 0 ) muKeys.push_back( triggerObjectsStandAlone->size() - 1 );
-      }
-      l1ObjectTypeMap.insert( std::make_pair( Mu, muKeys ) );
-    } else LogError( "l1ExtraValid" ) << "l1extra::L1MuonParticleCollection product with InputTag '" << tagL1ExtraMu_.encode() << "' not in event";
+  boost::ptr_vector< L1ExtraConversion > l1ExtraConversions;
+  addL1ExtraConversion< l1extra::L1MuonParticleCollection   >( iEvent, tagL1ExtraMu_     , "l1extra::L1MuonParticleCollection"  , trigger::TriggerL1Mu     , Mu     , mainBxOnly_, l1ExtraConversions );
+  addL1ExtraConversion< l1extra::L1EmParticleCollection     >( iEvent, tagL1ExtraNoIsoEG_, "l1extra::L1EmParticleCollection"    , trigger::TriggerL1NoIsoEG, NoIsoEG, mainBxOnly_, l1ExtraConversions );
+  addL1ExtraConversion< l1extra::L1EmParticleCollection     >( iEvent, tagL1ExtraIsoEG_  , "l1extra::L1EmParticleCollection"    , trigger::TriggerL1IsoEG  , IsoEG  , mainBxOnly_, l1ExtraConversions );
+  addL1ExtraConversion< l1extra::L1JetParticleCollection    >( iEvent, tagL1ExtraCenJet_ , "l1extra::L1JetParticleCollection"   , trigger::TriggerL1CenJet , CenJet , mainBxOnly_, l1ExtraConversions );
+  addL1ExtraConversion< l1extra::L1JetParticleCollection    >( iEvent, tagL1ExtraForJet_ , "l1extra::L1JetParticleCollection"   , trigger::TriggerL1ForJet , ForJet , mainBxOnly_, l1ExtraConversions );
+  addL1ExtraConversion< l1extra::L1JetParticleCollection    >( iEvent, tagL1ExtraTauJet_ , "l1extra::L1JetParticleCollection"   , trigger::TriggerL1TauJet , TauJet , mainBxOnly_, l1ExtraConversions );
+  addL1ExtraConversion< l1extra::L1EtMissParticleCollection >( iEvent, tagL1ExtraETM_    , "l1extra::L1EtMissParticleCollection", trigger::TriggerL1ETM    , ETM    , mainBxOnly_, l1ExtraConversions );
+  addL1ExtraConversion< l1extra::L1EtMissParticleCollection >( iEvent, tagL1ExtraHTM_    , "l1extra::L1EtMissParticleCollection", trigger::TriggerL1HTM    , HTM    , mainBxOnly_, l1ExtraConversions );
+  // assign the output ranges and size the output once
+  size_t sizeL1Objects( 0 );
+  for ( boost::ptr_vector< L1ExtraConversion >::iterator iC = l1ExtraConversions.begin(); iC != l1ExtraConversions.end(); ++iC ) {
+    iC->setOffset( sizeL1Objects );
+    sizeL1Objects += iC->size();
   }
-  if ( ! tagL1ExtraNoIsoEG_.label().empty() ) {
-    Handle< l1extra::L1EmParticleCollection > handleL1ExtraNoIsoEG;
-    iEvent.getByLabel( tagL1ExtraNoIsoEG_, handleL1ExtraNoIsoEG );
-    if ( handleL1ExtraNoIsoEG.isValid() ) {
-      std::vector< unsigned > noIsoEGKeys;
-      for ( size_t l1NoIsoEG = 0; l1NoIsoEG < handleL1ExtraNoIsoEG->size(); ++l1NoIsoEG ) {
-        if ( mainBxOnly_ && handleL1ExtraNoIsoEG->at( l1NoIsoEG ).bx() != 0 ) continue;
-        TriggerObject triggerObject;
-        if ( saveL1Refs_ ) {
-          const reco::CandidateBaseRef leafCandRef( l1extra::L1EmParticleRef( handleL1ExtraNoIsoEG, l1NoIsoEG ) );
-          triggerObject = TriggerObject( leafCandRef );
-        } else {
-          const reco::LeafCandidate leafCandidate( *( handleL1ExtraNoIsoEG->at( l1NoIsoEG ).reco::LeafCandidate::clone() ) );
-          triggerObject = TriggerObject( leafCandidate );
-        }
-        triggerObject.setCollection( tagL1ExtraNoIsoEG_ );
-        triggerObject.addTriggerObjectType( trigger::TriggerL1NoIsoEG );
-        if ( ! onlyStandAlone_ ) triggerObjects->push_back( triggerObject );
-        TriggerObjectStandAlone triggerObjectStandAlone( triggerObject );
-        triggerObjectsStandAlone->push_back( triggerObjectStandAlone );
-        if ( handleL1ExtraNoIsoEG->at( l1NoIsoEG ).bx() == 0 ) noIsoEGKeys.push_back( triggerObjectsStandAlone->size() - 1 );
-      }
-      l1ObjectTypeMap.insert( std::make_pair( NoIsoEG, noIsoEGKeys ) );
-    } else LogError( "l1ExtraValid" ) << "l1extra::L1EmParticleCollection product with InputTag '" << tagL1ExtraNoIsoEG_.encode() << "' not in event";
+  const size_t firstL1Object( triggerObjects->size() );
+  const size_t firstL1ObjectStandAlone( triggerObjectsStandAlone->size() );
+  if ( sizeL1Objects > arena_.maxSizeL1Objects ) arena_.maxSizeL1Objects = sizeL1Objects;
+  if ( triggerObjectsStandAlone->capacity() < firstL1ObjectStandAlone + sizeL1Objects ) ++arena_.nOutputGrowths;
+  if ( sizeL1Objects > 0 ) {
+    if ( ! onlyStandAlone_ ) triggerObjects->resize( firstL1Object + sizeL1Objects );
+    triggerObjectsStandAlone->resize( firstL1ObjectStandAlone + sizeL1Objects );
+    const L1ExtraConversionBody l1ExtraConversionBody( l1ExtraConversions, saveL1Refs_, onlyStandAlone_ ? 0 : &( triggerObjects->at( firstL1Object ) ), &( triggerObjectsStandAlone->at( firstL1ObjectStandAlone ) ) );
+    const tbb::blocked_range< size_t > rangeL1ExtraConversions( 0, l1ExtraConversions.size(), 1 );
+    // the conversions write to disjoint ranges of the output only
+    if ( l1ExtraConcurrent_ ) tbb::parallel_for( rangeL1ExtraConversions, l1ExtraConversionBody );
+    else                      l1ExtraConversionBody( rangeL1ExtraConversions );
   }
-  if ( ! tagL1ExtraIsoEG_.label().empty() ) {
-    Handle< l1extra::L1EmParticleCollection > handleL1ExtraIsoEG;
-    iEvent.getByLabel( tagL1ExtraIsoEG_, handleL1ExtraIsoEG );
-    if ( handleL1ExtraIsoEG.isValid() ) {
-      std::vector< unsigned > isoEGKeys;
-      for ( size_t l1IsoEG = 0; l1IsoEG < handleL1ExtraIsoEG->size(); ++l1IsoEG ) {
-        if ( mainBxOnly_ && handleL1ExtraIsoEG->at( l1IsoEG ).bx() != 0 ) continue;
-        TriggerObject triggerObject;
-        if ( saveL1Refs_ ) {
-          const reco::CandidateBaseRef leafCandRef( l1extra::L1EmParticleRef( handleL1ExtraIsoEG, l1IsoEG ) );
-          triggerObject = TriggerObject( leafCandRef );
-        } else {
-          const reco::LeafCandidate leafCandidate( *( handleL1ExtraIsoEG->at( l1IsoEG ).reco::LeafCandidate::clone() ) );
-          triggerObject = TriggerObject( leafCandidate );
-        }
-        triggerObject.setCollection( tagL1ExtraIsoEG_ );
-        triggerObject.addTriggerObjectType( trigger::TriggerL1IsoEG );
-        if ( ! onlyStandAlone_ ) triggerObjects->push_back( triggerObject );
-        TriggerObjectStandAlone triggerObjectStandAlone( triggerObject );
-        triggerObjectsStandAlone->push_back( triggerObjectStandAlone );
-        if ( handleL1ExtraIsoEG->at( l1IsoEG ).bx() == 0 ) isoEGKeys.push_back( triggerObjectsStandAlone->size() - 1 );
-      }
-      l1ObjectTypeMap.insert( std::make_pair( IsoEG, isoEGKeys ) );
-    } else LogError( "l1ExtraValid" ) << "l1extra::L1EmParticleCollection product with InputTag '" << tagL1ExtraIsoEG_.encode() << "' not in event";
-  }
-  if ( ! tagL1ExtraCenJet_.label().empty() ) {
-    Handle< l1extra::L1JetParticleCollection > handleL1ExtraCenJet;
-    iEvent.getByLabel( tagL1ExtraCenJet_, handleL1ExtraCenJet );
-    if ( handleL1ExtraCenJet.isValid() ) {
-      std::vector< unsigned > cenJetKeys;
-      for ( size_t l1CenJet = 0; l1CenJet < handleL1ExtraCenJet->size(); ++l1CenJet ) {
-        if ( mainBxOnly_ && handleL1ExtraCenJet->at( l1CenJet ).bx() != 0 ) continue;
-        TriggerObject triggerObject;
-        if ( saveL1Refs_ ) {
-          const reco::CandidateBaseRef leafCandRef( l1extra::L1JetParticleRef( handleL1ExtraCenJet, l1CenJet ) );
-          triggerObject = TriggerObject( leafCandRef );
-        } else {
-          const reco::LeafCandidate leafCandidate( *( handleL1ExtraCenJet->at( l1CenJet ).reco::LeafCandidate::clone() ) );
-          triggerObject = TriggerObject( leafCandidate );
-        }
-        triggerObject.setCollection( tagL1ExtraCenJet_ );
-        triggerObject.addTriggerObjectType( trigger::TriggerL1CenJet );
-        if ( ! onlyStandAlone_ ) triggerObjects->push_back( triggerObject );
-        TriggerObjectStandAlone triggerObjectStandAlone( triggerObject );
-        triggerObjectsStandAlone->push_back( triggerObjectStandAlone );
-        if ( handleL1ExtraCenJet->at( l1CenJet ).bx() == 0 ) cenJetKeys.push_back( triggerObjectsStandAlone->size() - 1 );
-      }
-      l1ObjectTypeMap.insert( std::make_pair( CenJet, cenJetKeys ) );
-    } else LogError( "l1ExtraValid" ) << "l1extra::L1JetParticleCollection product with InputTag '" << tagL1ExtraCenJet_.encode() << "' not in event";
-  }
-  if ( ! tagL1ExtraForJet_.label().empty() ) {
-    Handle< l1extra::L1JetParticleCollection > handleL1ExtraForJet;
-    iEvent.getByLabel( tagL1ExtraForJet_, handleL1ExtraForJet );
-    if ( handleL1ExtraForJet.isValid() ) {
-      std::vector< unsigned > forJetKeys;
-      for ( size_t l1ForJet = 0; l1ForJet < handleL1ExtraForJet->size(); ++l1ForJet ) {
-        if ( mainBxOnly_ && handleL1ExtraForJet->at( l1ForJet ).bx() != 0 ) continue;
-        TriggerObject triggerObject;
-        if ( saveL1Refs_ ) {
-          const reco::CandidateBaseRef leafCandRef( l1extra::L1JetParticleRef( handleL1ExtraForJet, l1ForJet ) );
-          triggerObject = TriggerObject( leafCandRef );
-        } else {
-          const reco::LeafCandidate leafCandidate( *( handleL1ExtraForJet->at( l1ForJet ).reco::LeafCandidate::clone() ) );
-          triggerObject = TriggerObject( leafCandidate );
-        }
-        triggerObject.setCollection( tagL1ExtraForJet_ );
-        triggerObject.addTriggerObjectType( trigger::TriggerL1ForJet );
-        if ( ! onlyStandAlone_ ) triggerObjects->push_back( triggerObject );
-        TriggerObjectStandAlone triggerObjectStandAlone( triggerObject );
-        triggerObjectsStandAlone->push_back( triggerObjectStandAlone );
-        if ( handleL1ExtraForJet->at( l1ForJet ).bx() == 0 ) forJetKeys.push_back( triggerObjectsStandAlone->size() - 1 );
-      }
-      l1ObjectTypeMap.insert( std::make_pair( ForJet, forJetKeys ) );
-    } else LogError( "l1ExtraValid" ) << "l1extra::L1JetParticleCollection product with InputTag '" << tagL1ExtraForJet_.encode() << "' not in event";
-  }
-  if ( ! tagL1ExtraTauJet_.label().empty() ) {
-    Handle< l1extra::L1JetParticleCollection > handleL1ExtraTauJet;
-    iEvent.getByLabel( tagL1ExtraTauJet_, handleL1ExtraTauJet );
-    if ( handleL1ExtraTauJet.isValid() ) {
-      std::vector< unsigned > tauJetKeys;
-      for ( size_t l1TauJet = 0; l1TauJet < handleL1ExtraTauJet->size(); ++l1TauJet ) {
-        if ( mainBxOnly_ && handleL1ExtraTauJet->at( l1TauJet ).bx() != 0 ) continue;
-        TriggerObject triggerObject;
-        if ( saveL1Refs_ ) {
-          const reco::CandidateBaseRef leafCandRef( l1extra::L1JetParticleRef( handleL1ExtraTauJet, l1TauJet ) );
-          triggerObject = TriggerObject( leafCandRef );
-        } else {
-          const reco::LeafCandidate leafCandidate( *( handleL1ExtraTauJet->at( l1TauJet ).reco::LeafCandidate::clone() ) );
-          triggerObject = TriggerObject( leafCandidate );
-        }
-        triggerObject.setCollection( tagL1ExtraTauJet_ );
-        triggerObject.addTriggerObjectType( trigger::TriggerL1TauJet );
-        if ( ! onlyStandAlone_ ) triggerObjects->push_back( triggerObject );
-        TriggerObjectStandAlone triggerObjectStandAlone( triggerObject );
-        triggerObjectsStandAlone->push_back( triggerObjectStandAlone );
-        if ( handleL1ExtraTauJet->at( l1TauJet ).bx() == 0 ) tauJetKeys.push_back( triggerObjectsStandAlone->size() - 1 );
-      }
-      l1ObjectTypeMap.insert( std::make_pair( TauJet, tauJetKeys ) );
-    } else LogError( "l1ExtraValid" ) << "l1extra::L1JetParticleCollection product with InputTag '" << tagL1ExtraTauJet_.encode() << "' not in event";
-  }
-  if ( ! tagL1ExtraETM_ .label().empty()) {
-    Handle< l1extra::L1EtMissParticleCollection > handleL1ExtraETM;
-    iEvent.getByLabel( tagL1ExtraETM_, handleL1ExtraETM );
-    if ( handleL1ExtraETM.isValid() ) {
-      std::vector< unsigned > etmKeys;
-      for ( size_t l1ETM = 0; l1ETM < handleL1ExtraETM->size(); ++l1ETM ) {
-        if ( mainBxOnly_ && handleL1ExtraETM->at( l1ETM ).bx() != 0 ) continue;
-        TriggerObject triggerObject;
-        if ( saveL1Refs_ ) {
-          const reco::CandidateBaseRef leafCandRef( l1extra::L1EtMissParticleRef( handleL1ExtraETM, l1ETM ) );
-          triggerObject = TriggerObject( leafCandRef );
-        } else {
-          const reco::LeafCandidate leafCandidate( *( handleL1ExtraETM->at( l1ETM ).reco::LeafCandidate::clone() ) );
-          triggerObject = TriggerObject( leafCandidate );
-        }
-        triggerObject.setCollection( tagL1ExtraETM_ );
-        triggerObject.addTriggerObjectType( trigger::TriggerL1ETM );
-        if ( ! onlyStandAlone_ ) triggerObjects->push_back( triggerObject );
-        TriggerObjectStandAlone triggerObjectStandAlone( triggerObject );
-        triggerObjectsStandAlone->push_back( triggerObjectStandAlone );
-        if ( handleL1ExtraETM->at( l1ETM ).bx() == 0 ) etmKeys.push_back( triggerObjectsStandAlone->size() - 1 );
-      }
-      l1ObjectTypeMap.insert( std::make_pair( ETM, etmKeys ) );
-    } else LogError( "l1ExtraValid" ) << "l1extra::L1EtMissParticleCollection product with InputTag '" << tagL1ExtraETM_.encode() << "' not in event";
-  }
-  if ( ! tagL1ExtraHTM_.label().empty() ) {
-    Handle< l1extra::L1EtMissParticleCollection > handleL1ExtraHTM;
-    iEvent.getByLabel( tagL1ExtraHTM_, handleL1ExtraHTM );
-    if ( handleL1ExtraHTM.isValid() ) {
-      std::vector< unsigned > htmKeys;
-      for ( size_t l1HTM = 0; l1HTM < handleL1ExtraHTM->size(); ++l1HTM ) {
-        if ( mainBxOnly_ && handleL1ExtraHTM->at( l1HTM ).bx() != 0 ) continue;
-        TriggerObject triggerObject;
-        if ( saveL1Refs_ ) {
-          const reco::CandidateBaseRef leafCandRef( l1extra::L1EtMissParticleRef( handleL1ExtraHTM, l1HTM ) );
-          triggerObject = TriggerObject( leafCandRef );
-        } else {
-          const reco::LeafCandidate leafCandidate( *( handleL1ExtraHTM->at( l1HTM ).reco::LeafCandidate::clone() ) );
-          triggerObject = TriggerObject( leafCandidate );
-        }
-        triggerObject.setCollection( tagL1ExtraHTM_ );
-        triggerObject.addTriggerObjectType( trigger::TriggerL1HTM );
-        if ( ! onlyStandAlone_ ) triggerObjects->push_back( triggerObject );
-        TriggerObjectStandAlone triggerObjectStandAlone( triggerObject );
-        triggerObjectsStandAlone->push_back( triggerObjectStandAlone );
-        if ( handleL1ExtraHTM->at( l1HTM ).bx() == 0 ) htmKeys.push_back( triggerObjectsStandAlone->size() - 1 );
-      }
-      l1ObjectTypeMap.insert( std::make_pair( HTM, htmKeys ) );
-    } else LogError( "l1ExtraValid" ) << "l1extra::L1EtMissParticleCollection product with InputTag '" << tagL1ExtraHTM_.encode() << "' not in event";
+  for ( boost::ptr_vector< L1ExtraConversion >::const_iterator iC = l1ExtraConversions.begin(); iC != l1ExtraConversions.end(); ++iC ) {
+    l1ObjectTypeMap.insert( std::make_pair( iC->l1GtObject(), iC->keys( firstL1ObjectStandAlone ) ) );
   }
 
   // Put trigger objects to event
@@ -737,31 +746,8 @@ void PATTriggerProducer::produce( Event& iEvent, const EventSetup& iSetup )
     std::auto_ptr< TriggerAlgorithmCollection > triggerAlgos( new TriggerAlgorithmCollection() );
     std::auto_ptr< TriggerConditionCollection > triggerConditions( new TriggerConditionCollection() );
     if ( addL1Algos_ ) {
-      // create trigger object types transalation map (yes, it's ugly!)
-      std::map< L1GtObject, trigger::TriggerObjectType > mapObjectTypes;
-      mapObjectTypes.insert( std::make_pair( Mu     , trigger::TriggerL1Mu ) );
-      mapObjectTypes.insert( std::make_pair( NoIsoEG, trigger::TriggerL1NoIsoEG ) );
-      mapObjectTypes.insert( std::make_pair( IsoEG  , trigger::TriggerL1IsoEG ) );
-      mapObjectTypes.insert( std::make_pair( CenJet , trigger::TriggerL1CenJet ) );
-      mapObjectTypes.insert( std::make_pair( ForJet , trigger::TriggerL1ForJet ) );
-      mapObjectTypes.insert( std::make_pair( TauJet , trigger::TriggerL1TauJet ) );
-      mapObjectTypes.insert( std::make_pair( ETM    , trigger::TriggerL1ETM ) );
-      mapObjectTypes.insert( std::make_pair( HTM    , trigger::TriggerL1HTM ) );
       // get and cache L1 menu
       l1GtUtils_.getL1GtRunCache( iEvent, iSetup, useL1EventSetup, useL1GtTriggerMenuLite );
-      ESHandle< L1GtTriggerMenu > handleL1GtTriggerMenu;
-      iSetup.get< L1GtTriggerMenuRcd >().get( handleL1GtTriggerMenu );
-      L1GtTriggerMenu l1GtTriggerMenu( *handleL1GtTriggerMenu );
-      const AlgorithmMap l1GtAlgorithms( l1GtTriggerMenu.gtAlgorithmMap() );
-      const AlgorithmMap l1GtTechTriggers( l1GtTriggerMenu.gtTechnicalTriggerMap() );
-      l1GtTriggerMenu.buildGtConditionMap();
-      const std::vector< ConditionMap > l1GtConditionsVector( l1GtTriggerMenu.gtConditionMap() );
-      // cache conditions in one single condition map
-      ConditionMap l1GtConditions;
-      for ( size_t iCv = 0; iCv < l1GtConditionsVector.size(); ++iCv ) {
-        l1GtConditions.insert( l1GtConditionsVector.at( iCv ).begin(), l1GtConditionsVector.at( iCv ).end() );
-      }
-      triggerAlgos->reserve( l1GtAlgorithms.size() + l1GtTechTriggers.size() );
       Handle< L1GlobalTriggerObjectMaps > handleL1GlobalTriggerObjectMaps;
       iEvent.getByLabel( tagL1GlobalTriggerObjectMaps_, handleL1GlobalTriggerObjectMaps );
       if( ! handleL1GlobalTriggerObjectMaps.isValid() ) {
@@ -781,11 +767,23 @@ void PATTriggerProducer::produce( Event& iEvent, const EventSetup& iSetup )
                                    << "Skipping conditions for all L1 physics algorithm names in this event";
         }
       }
+      // (re-)compile the menu topology only, if the L1 menu or the ParameterSet registry entry might have changed
+      const unsigned long long l1GtTriggerMenuCacheId( iSetup.get< L1GtTriggerMenuRcd >().cacheIdentifier() );
+      if ( firstInRun_ || l1GtTriggerMenuCacheId != l1GtTriggerMenuCacheId_ ) {
+        ESHandle< L1GtTriggerMenu > handleL1GtTriggerMenu;
+        iSetup.get< L1GtTriggerMenuRcd >().get( handleL1GtTriggerMenu );
+        buildL1Topology( *handleL1GtTriggerMenu );
+        l1GtTriggerMenuCacheId_ = l1GtTriggerMenuCacheId;
+      }
+      triggerAlgos->reserve( l1Algorithms_.size() + l1TechTriggers_.size() );
+      triggerConditions->reserve( arena_.maxSizeTriggerConditions );
+      // keys of the conditions already produced in this event, by index in l1Conditions_
+      std::vector< int > conditionKeys( l1Conditions_.size(), -1 );
       // physics algorithms
-      for ( CItAlgo iAlgo = l1GtAlgorithms.begin(); iAlgo != l1GtAlgorithms.end(); ++iAlgo ) {
-        const std::string & algoName( iAlgo->second.algoName() );
-        if ( ! ( iAlgo->second.algoBitNumber() < int( L1GlobalTriggerReadoutSetup::NumberPhysTriggers ) ) ) {
-          LogError( "l1Algo" ) << "L1 physics algorithm '" << algoName << "' has bit number " << iAlgo->second.algoBitNumber() << " >= " << L1GlobalTriggerReadoutSetup::NumberPhysTriggers << "\n"
+      for ( std::vector< L1AlgorithmInfo >::const_iterator iAlgo = l1Algorithms_.begin(); iAlgo != l1Algorithms_.end(); ++iAlgo ) {
+        const std::string & algoName( iAlgo->name );
+        if ( ! ( iAlgo->bitNumber < int( L1GlobalTriggerReadoutSetup::NumberPhysTriggers ) ) ) {
+          LogError( "l1Algo" ) << "L1 physics algorithm '" << algoName << "' has bit number " << iAlgo->bitNumber << " >= " << L1GlobalTriggerReadoutSetup::NumberPhysTriggers << "\n"
                                << "Skipping";
           continue;
         }
@@ -811,8 +809,8 @@ void PATTriggerProducer::produce( Event& iEvent, const EventSetup& iSetup )
                                << "Skipping";
           continue;
         }
-        TriggerAlgorithm triggerAlgo( algoName, iAlgo->second.algoAlias(), category == L1GtUtils::TechnicalTrigger, (unsigned)bit, (unsigned)prescale, (bool)mask, decisionBeforeMask, decisionAfterMask );
-        triggerAlgo.setLogicalExpression( iAlgo->second.algoLogicalExpression() );
+        TriggerAlgorithm triggerAlgo( algoName, iAlgo->alias, category == L1GtUtils::TechnicalTrigger, (unsigned)bit, (unsigned)prescale, (bool)mask, decisionBeforeMask, decisionAfterMask );
+        triggerAlgo.setLogicalExpression( iAlgo->logicalExpression );
         // GTL result and used conditions in physics algorithm
         if( ! handleL1GlobalTriggerObjectMaps.isValid() ) {
           triggerAlgos->push_back( triggerAlgo );
@@ -838,7 +836,7 @@ void PATTriggerProducer::produce( Event& iEvent, const EventSetup& iSetup )
           triggerAlgos->push_back( triggerAlgo );
           continue;
         }
-        if (!l1PSet_->exists(algoName)) {
+        if ( ! iAlgo->inPSet ) {
           if ( firstInRun_ ) {
             LogError( "l1ObjectMap" ) << "L1 physics algorithm name '" << algoName << "' not available in ParameterSet registry\n"
                                       << "Skipping conditions for this algorithm in this run";
@@ -849,29 +847,30 @@ void PATTriggerProducer::produce( Event& iEvent, const EventSetup& iSetup )
           triggerAlgos->push_back( triggerAlgo );
           continue;
         }
-        std::vector<std::string> conditionNames( l1PSet_->getParameter<std::vector<std::string> >(algoName) );
 
-        for ( unsigned iT = 0; iT < conditionNames.size(); ++iT ) {
-          size_t key( triggerConditions->size() );
-          for ( size_t iC = 0; iC < triggerConditions->size(); ++iC ) {
-            if ( conditionNames.at(iT) == triggerConditions->at( iC ).name() ) {
-              key = iC;
-              break;
-            }
-          }
+        for ( unsigned iT = 0; iT < iAlgo->conditionIndices.size(); ++iT ) {
+          const unsigned indexCond( iAlgo->conditionIndices.at( iT ) );
+          const L1ConditionInfo & l1Cond( l1Conditions_.at( indexCond ) );
+          size_t key( conditionKeys.at( indexCond ) < 0 ? triggerConditions->size() : size_t( conditionKeys.at( indexCond ) ) );
           if ( key == triggerConditions->size() ) {
             if ( iT >= conditions.nConditions() ) {
               LogError( "l1CondMap" ) << "More condition names from ParameterSet registry than the " << conditions.nConditions() << " conditions in L1GlobalTriggerObjectMaps\n"
-                                      << "Skipping condition " << conditionNames.at(iT) << " in algorithm " << algoName;
+                                      << "Skipping condition " << l1Cond.name << " in algorithm " << algoName;
               break;
             }
-            TriggerCondition triggerCond( conditionNames[iT], conditions.getConditionResult(iT) );
-            if ( l1GtConditions.find( triggerCond.name() ) != l1GtConditions.end() ) {
-              triggerCond.setCategory( l1GtConditions[ triggerCond.name() ]->condCategory() );
-              triggerCond.setType( l1GtConditions[ triggerCond.name() ]->condType() );
-              const std::vector< L1GtObject > l1ObjectTypes( l1GtConditions[ triggerCond.name() ]->objectType() );
+            TriggerCondition triggerCond( l1Cond.name, conditions.getConditionResult(iT) );
+            if ( l1Cond.inMenu ) {
+              triggerCond.setCategory( l1Cond.category );
+              triggerCond.setType( l1Cond.type );
+              const std::vector< L1GtObject > & l1ObjectTypes( l1Cond.l1ObjectTypes );
+              for ( size_t iType = 0 ; iType < l1Cond.triggerObjectTypes.size(); ++iType ) {
+                triggerCond.addTriggerObjectType( l1Cond.triggerObjectTypes.at( iType ) );
+              }
+              // this event's object keys per object type in the condition
+              std::vector< const std::vector< unsigned > * > l1ObjectKeys( l1ObjectTypes.size(), 0 );
               for ( size_t iType = 0 ; iType < l1ObjectTypes.size(); ++iType ) {
-                triggerCond.addTriggerObjectType( mapObjectTypes[ l1ObjectTypes.at( iType ) ] );
+                std::map< L1GtObject, std::vector< unsigned > >::const_iterator iKeys( l1ObjectTypeMap.find( l1ObjectTypes.at( iType ) ) );
+                if ( iKeys != l1ObjectTypeMap.end() ) l1ObjectKeys.at( iType ) = &( iKeys->second );
               }
               // objects in condition
               L1GlobalTriggerObjectMaps::CombinationsInCondition combinations = handleL1GlobalTriggerObjectMaps->getCombinationsInCondition(bit, iT);
@@ -882,12 +881,12 @@ void PATTriggerProducer::produce( Event& iEvent, const EventSetup& iSetup )
                   if ( iV >= l1ObjectTypes.size() ) {
                     LogError( "l1CondMap" ) << "Index " << iV << " in combinations vector overshoots size " << l1ObjectTypes.size() << " of types vector in conditions map\n"
                                             << "Skipping object key in condition " << triggerCond.name();
-                  } else if ( l1ObjectTypeMap.find( l1ObjectTypes.at( iV ) ) != l1ObjectTypeMap.end() ) {
-                    if ( objectIndex >= l1ObjectTypeMap[ l1ObjectTypes.at( iV ) ].size() ) {
-                      LogError( "l1CondMap" ) << "Index " << objectIndex << " in combination overshoots number " << l1ObjectTypeMap[ l1ObjectTypes.at( iV ) ].size() << "of according trigger objects\n"
+                  } else if ( l1ObjectKeys.at( iV ) != 0 ) {
+                    if ( objectIndex >= l1ObjectKeys.at( iV )->size() ) {
+                      LogError( "l1CondMap" ) << "Index " << objectIndex << " in combination overshoots number " << l1ObjectKeys.at( iV )->size() << "of according trigger objects\n"
                                               << "Skipping object key in condition " << triggerCond.name();
                     }
-                    const unsigned objectKey( l1ObjectTypeMap[ l1ObjectTypes.at( iV ) ].at( objectIndex ) );
+                    const unsigned objectKey( l1ObjectKeys.at( iV )->at( objectIndex ) );
                     triggerCond.addObjectKey( objectKey );
                     // add current condition and algorithm also to the according stand-alone trigger object
                     triggerObjectsStandAlone->at( objectKey ).addAlgorithmName( triggerAlgo.name(), ( triggerAlgo.decision() && triggerCond.wasAccept() ) );
@@ -899,6 +898,7 @@ void PATTriggerProducer::produce( Event& iEvent, const EventSetup& iSetup )
               LogWarning( "l1CondMap" ) << "L1 conditions '" << triggerCond.name() << "' not found in the L1 menu\n"
                                         << "Remains incomplete";
             }
+            conditionKeys.at( indexCond ) = int( key );
             triggerConditions->push_back( triggerCond );
           }
           triggerAlgo.addConditionKey( key );
@@ -906,10 +906,10 @@ void PATTriggerProducer::produce( Event& iEvent, const EventSetup& iSetup )
         triggerAlgos->push_back( triggerAlgo );
       }
       // technical triggers
-      for ( CItAlgo iAlgo = l1GtTechTriggers.begin(); iAlgo != l1GtTechTriggers.end(); ++iAlgo ) {
-        const std::string & algoName( iAlgo->second.algoName() );
-        if ( ! ( iAlgo->second.algoBitNumber() < int( L1GlobalTriggerReadoutSetup::NumberTechnicalTriggers ) ) ) {
-          LogError( "l1Algo" ) << "L1 technical trigger '" << algoName << "' has bit number " << iAlgo->second.algoBitNumber() << " >= " << L1GlobalTriggerReadoutSetup::NumberTechnicalTriggers << "\n"
+      for ( std::vector< L1AlgorithmInfo >::const_iterator iAlgo = l1TechTriggers_.begin(); iAlgo != l1TechTriggers_.end(); ++iAlgo ) {
+        const std::string & algoName( iAlgo->name );
+        if ( ! ( iAlgo->bitNumber < int( L1GlobalTriggerReadoutSetup::NumberTechnicalTriggers ) ) ) {
+          LogError( "l1Algo" ) << "L1 technical trigger '" << algoName << "' has bit number " << iAlgo->bitNumber << " >= " << L1GlobalTriggerReadoutSetup::NumberTechnicalTriggers << "\n"
                                << "Skipping";
           continue;
         }
@@ -935,13 +935,17 @@ void PATTriggerProducer::produce( Event& iEvent, const EventSetup& iSetup )
                                << "Skipping";
           continue;
         }
-        TriggerAlgorithm triggerAlgo( algoName, iAlgo->second.algoAlias(), category == L1GtUtils::TechnicalTrigger, (unsigned)bit, (unsigned)prescale, (bool)mask, decisionBeforeMask, decisionAfterMask );
-        triggerAlgo.setLogicalExpression( iAlgo->second.algoLogicalExpression() );
+        TriggerAlgorithm triggerAlgo( algoName, iAlgo->alias, category == L1GtUtils::TechnicalTrigger, (unsigned)bit, (unsigned)prescale, (bool)mask, decisionBeforeMask, decisionAfterMask );
+        triggerAlgo.setLogicalExpression( iAlgo->logicalExpression );
         triggerAlgos->push_back( triggerAlgo );
       }
     }
 
     // Put L1 algorithms and conditions to event
+    if ( triggerConditions->size() > arena_.maxSizeTriggerConditions ) {
+      if ( arena_.maxSizeTriggerConditions > 0 ) ++arena_.nOutputGrowths;
+      arena_.maxSizeTriggerConditions = triggerConditions->size();
+    }
     iEvent.put( triggerAlgos );
     iEvent.put( triggerConditions );
   }
@@ -950,6 +954,105 @@ void PATTriggerProducer::produce( Event& iEvent, const EventSetup& iSetup )
   iEvent.put( triggerObjectsStandAlone );
 
   firstInRun_ = false;
+  ++arena_.nEvents;
+
+}
+
+
+void PATTriggerProducer::endJob()
+{
+
+  LogInfo( "eventArena" ) << "Event arena after " << arena_.nEvents << " events:\n"
+                          << "  growths of the scratch containers       : " << arena_.nScratchGrowths << "\n"
+                          << "  module state nodes allocated            : " << arena_.nModuleStateNodes << " (" << arena_.moduleStates.size() << " in use)\n"
+                          << "  growths of the output collections       : " << arena_.nOutputGrowths << "\n"
+                          << "  maximum number of L1 objects            : " << arena_.maxSizeL1Objects << "\n"
+                          << "  maximum number of L1 conditions         : " << arena_.maxSizeTriggerConditions;
+
+}
+
+void PATTriggerProducer::buildL1Topology( const L1GtTriggerMenu & l1GtTriggerMenuES )
+{
+
+  l1Algorithms_.clear();
+  l1TechTriggers_.clear();
+  l1Conditions_.clear();
+
+  // create trigger object types transalation map (yes, it's ugly!)
+  std::map< L1GtObject, trigger::TriggerObjectType > mapObjectTypes;
+  mapObjectTypes.insert( std::make_pair( Mu     , trigger::TriggerL1Mu ) );
+  mapObjectTypes.insert( std::make_pair( NoIsoEG, trigger::TriggerL1NoIsoEG ) );
+  mapObjectTypes.insert( std::make_pair( IsoEG  , trigger::TriggerL1IsoEG ) );
+  mapObjectTypes.insert( std::make_pair( CenJet , trigger::TriggerL1CenJet ) );
+  mapObjectTypes.insert( std::make_pair( ForJet , trigger::TriggerL1ForJet ) );
+  mapObjectTypes.insert( std::make_pair( TauJet , trigger::TriggerL1TauJet ) );
+  mapObjectTypes.insert( std::make_pair( ETM    , trigger::TriggerL1ETM ) );
+  mapObjectTypes.insert( std::make_pair( HTM    , trigger::TriggerL1HTM ) );
+
+  // cache conditions in one single condition map
+  L1GtTriggerMenu l1GtTriggerMenu( l1GtTriggerMenuES ); // condition map can only be built on a non-const menu
+  l1GtTriggerMenu.buildGtConditionMap();
+  const std::vector< ConditionMap > & l1GtConditionsVector( l1GtTriggerMenu.gtConditionMap() );
+  ConditionMap l1GtConditions;
+  for ( size_t iCv = 0; iCv < l1GtConditionsVector.size(); ++iCv ) {
+    l1GtConditions.insert( l1GtConditionsVector.at( iCv ).begin(), l1GtConditionsVector.at( iCv ).end() );
+  }
+
+  // physics algorithms with their conditions
+  std::map< std::string, unsigned > indicesConditions;
+  const AlgorithmMap & l1GtAlgorithms( l1GtTriggerMenu.gtAlgorithmMap() );
+  l1Algorithms_.reserve( l1GtAlgorithms.size() );
+  for ( CItAlgo iAlgo = l1GtAlgorithms.begin(); iAlgo != l1GtAlgorithms.end(); ++iAlgo ) {
+    L1AlgorithmInfo l1Algo;
+    l1Algo.name              = iAlgo->second.algoName();
+    l1Algo.alias             = iAlgo->second.algoAlias();
+    l1Algo.logicalExpression = iAlgo->second.algoLogicalExpression();
+    l1Algo.bitNumber         = iAlgo->second.algoBitNumber();
+    l1Algo.inPSet            = ( l1PSet_ != 0 && l1PSet_->exists( l1Algo.name ) );
+    if ( l1Algo.inPSet ) {
+      const std::vector< std::string > conditionNames( l1PSet_->getParameter< std::vector< std::string > >( l1Algo.name ) );
+      for ( unsigned iT = 0; iT < conditionNames.size(); ++iT ) {
+        std::map< std::string, unsigned >::const_iterator iIndex( indicesConditions.find( conditionNames.at( iT ) ) );
+        if ( iIndex != indicesConditions.end() ) {
+          l1Algo.conditionIndices.push_back( iIndex->second );
+          continue;
+        }
+        L1ConditionInfo l1Cond;
+        l1Cond.name     = conditionNames.at( iT );
+        l1Cond.inMenu   = false;
+        l1Cond.category = CondNull;
+        l1Cond.type     = TypeNull;
+        ConditionMap::const_iterator iCond( l1GtConditions.find( l1Cond.name ) );
+        if ( iCond != l1GtConditions.end() ) {
+          l1Cond.inMenu        = true;
+          l1Cond.category      = iCond->second->condCategory();
+          l1Cond.type          = iCond->second->condType();
+          l1Cond.l1ObjectTypes = iCond->second->objectType();
+          for ( size_t iType = 0 ; iType < l1Cond.l1ObjectTypes.size(); ++iType ) {
+            std::map< L1GtObject, trigger::TriggerObjectType >::const_iterator iMap( mapObjectTypes.find( l1Cond.l1ObjectTypes.at( iType ) ) );
+            l1Cond.triggerObjectTypes.push_back( iMap != mapObjectTypes.end() ? iMap->second : trigger::TriggerObjectType( 0 ) );
+          }
+        }
+        indicesConditions[ l1Cond.name ] = l1Conditions_.size();
+        l1Algo.conditionIndices.push_back( l1Conditions_.size() );
+        l1Conditions_.push_back( l1Cond );
+      }
+    }
+    l1Algorithms_.push_back( l1Algo );
+  }
+
+  // technical triggers
+  const AlgorithmMap & l1GtTechTriggers( l1GtTriggerMenu.gtTechnicalTriggerMap() );
+  l1TechTriggers_.reserve( l1GtTechTriggers.size() );
+  for ( CItAlgo iAlgo = l1GtTechTriggers.begin(); iAlgo != l1GtTechTriggers.end(); ++iAlgo ) {
+    L1AlgorithmInfo l1Algo;
+    l1Algo.name              = iAlgo->second.algoName();
+    l1Algo.alias             = iAlgo->second.algoAlias();
+    l1Algo.logicalExpression = iAlgo->second.algoLogicalExpression();
+    l1Algo.bitNumber         = iAlgo->second.algoBitNumber();
+    l1Algo.inPSet            = false;
+    l1TechTriggers_.push_back( l1Algo );
+  }
 
 }
 
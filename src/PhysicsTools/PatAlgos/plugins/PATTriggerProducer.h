@@ -41,13 +41,21 @@
 #include "FWCore/Framework/interface/EDProducer.h"
 
 #include <string>
+#include <vector>
+#include <map>
+#include <utility>
 
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
 #include "FWCore/Utilities/interface/InputTag.h"
 
 #include "L1Trigger/GlobalTriggerAnalyzer/interface/L1GtUtils.h"
+#include "CondFormats/L1TObjects/interface/L1GtDefinitions.h"
+#include "DataFormats/L1GlobalTrigger/interface/L1GtObject.h"
+#include "DataFormats/HLTReco/interface/TriggerTypeDefs.h"
 #include "HLTrigger/HLTcore/interface/HLTConfigProvider.h"
 
+class L1GtTriggerMenu;
+
 namespace pat {
 
   class PATTriggerProducer : public edm::EDProducer {
@@ -62,6 +70,8 @@ namespace pat {
       virtual void beginRun(const edm::Run & iRun, const edm::EventSetup& iSetup) override;
       virtual void beginLuminosityBlock(const edm::LuminosityBlock & iLuminosityBlock, const edm::EventSetup& iSetup) override;
       virtual void produce( edm::Event & iEvent, const edm::EventSetup& iSetup) override;
+      virtual void endJob() override;
+      void buildL1Topology( const L1GtTriggerMenu & l1GtTriggerMenu );
 
       std::string nameProcess_;     // configuration
       bool        autoProcessName_;
@@ -90,6 +100,28 @@ namespace pat {
       bool                autoProcessNameL1ExtraHTM_;
       bool                mainBxOnly_;                    // configuration (optional with default)
       bool                saveL1Refs_;                    // configuration (optional with default)
+      bool                l1ExtraConcurrent_;             // configuration (optional with default)
+      // L1 menu topology (algorithms -> conditions -> object types), compiled once per L1 menu and run
+      struct L1ConditionInfo {
+        std::string                               name;
+        bool                                      inMenu;
+        L1GtConditionCategory                     category;
+        L1GtConditionType                         type;
+        std::vector< L1GtObject >                 l1ObjectTypes;
+        std::vector< trigger::TriggerObjectType > triggerObjectTypes;
+      };
+      struct L1AlgorithmInfo {
+        std::string             name;
+        std::string             alias;
+        std::string             logicalExpression;
+        int                     bitNumber;
+        bool                    inPSet;            // condition names available from the ParameterSet registry
+        std::vector< unsigned > conditionIndices;  // indices in l1Conditions_
+      };
+      std::vector< L1AlgorithmInfo > l1Algorithms_;
+      std::vector< L1AlgorithmInfo > l1TechTriggers_;
+      std::vector< L1ConditionInfo > l1Conditions_;
+      unsigned long long             l1GtTriggerMenuCacheId_;
       // HLT
       HLTConfigProvider         hltConfig_;
       bool                      hltConfigInit_;
@@ -127,6 +159,34 @@ namespace pat {
       };
       ModuleLabelToPathAndFlags moduleLabelToPathAndFlags_;
 
+      // HLT filter of a trigger object
+      struct FilterObject {
+        FilterObject( trigger::size_type k, unsigned f, int t ) : key( k ), filterIndex( f ), type( t ) {}
+        bool operator<( const FilterObject & other ) const { return key < other.key; }
+        trigger::size_type key;
+        unsigned           filterIndex;
+        int                type;
+      };
+      // Event-scope scratch space, kept between events to reuse its storage,
+      // and the sizes of the largest event so far to reserve the output collections
+      struct EventArena {
+        EventArena() : maxSizeL1Objects( 0 ), maxSizeTriggerConditions( 0 ), nEvents( 0 ), nScratchGrowths( 0 ), nModuleStateNodes( 0 ), nOutputGrowths( 0 ) {}
+        std::map< std::string, int >                                                 moduleStates;   // all module names of the HLT menu, states reset each event
+        std::vector< std::pair< unsigned, const std::string * > >                    indicesModules; // modules of the current path by slot
+        std::vector< std::string >                                                   filterLabels;   // by filter index
+        std::vector< const std::vector< ModuleLabelToPathAndFlags::PathAndFlags > * > filterPaths;    // by filter index
+        std::vector< FilterObject >                                                  filterObjects;  // sorted by object key
+        std::vector< unsigned >                                                      newObjectKeys;  // by HLT object key
+        size_t        maxSizeL1Objects;
+        size_t        maxSizeTriggerConditions;
+        // counters reported at the end of the job
+        unsigned long nEvents;
+        unsigned long nScratchGrowths;
+        unsigned long nModuleStateNodes;
+        unsigned long nOutputGrowths;
+      };
+      EventArena arena_;
+
   };
 }
 
@@ -0,0 +1,97 @@
+#ifndef PhysicsTools_PatAlgos_PATValueMapCache_h
+#define PhysicsTools_PatAlgos_PATValueMapCache_h
+
+
+// -*- C++ -*-
+//
+// Package:    PatAlgos
+// Class:      PATValueMapCache
+//
+/**
+  \class    pat::PATValueMapCache PATValueMapCache.h "PhysicsTools/PatAlgos/plugins/PATValueMapCache.h"
+  \brief    Per-event access to an edm::ValueMap with the product id resolved once
+
+   PATValueMapCache wraps the handle of an edm::ValueMap read in an event. The value ranges of the
+   requested products are kept, so repeated lookups for objects of the same collections are
+   plain array accesses instead of a product id search each.
+   Lookups for a product or index not in the map are forwarded to edm::ValueMap and throw the same way.
+
+  \version  $Id$
+*/
+
+
+#include "DataFormats/Common/interface/Handle.h"
+#include "DataFormats/Common/interface/ValueMap.h"
+#include "DataFormats/Provenance/interface/ProductID.h"
+
+#include <vector>
+
+
+namespace pat {
+
+  template< typename T >
+  class PATValueMapCache {
+
+    public:
+
+      typedef edm::ValueMap< T > map_type;
+
+      PATValueMapCache() {}
+
+      /// set the map of the current event
+      void setMap( const edm::Handle< map_type > & map ) {
+        map_ = map;
+        products_.clear();
+      }
+
+      /// 'true', if the map holds values for the product
+      bool contains( const edm::ProductID & id ) const { return resolve( id ).found; }
+
+      /// value for the object with index 'idx' in the product
+      typename map_type::const_reference_type get( const edm::ProductID & id, size_t idx ) const {
+        const Product & product( resolve( id ) );
+        if ( product.found && idx < product.size ) return product.values[ idx ];
+        return map_->get( id, idx );
+      }
+
+      /// value for a Ref, RefToBase or Ptr
+      template< typename R >
+      typename map_type::const_reference_type operator[]( const R & ref ) const { return get( ref.id(), ref.key() ); }
+
+    private:
+
+      /// value range of one product in the map
+      struct Product {
+        Product() : found( false ), size( 0 ) {}
+        edm::ProductID                                id;
+        bool                                          found;
+        size_t                                        size;
+        typename map_type::container::const_iterator values;
+      };
+
+      /// only a few products are requested per map, so a linear search is sufficient
+      const Product & resolve( const edm::ProductID & id ) const {
+        for ( typename std::vector< Product >::const_iterator iProduct = products_.begin(); iProduct != products_.end(); ++iProduct ) {
+          if ( iProduct->id == id ) return *iProduct;
+        }
+        Product product;
+        product.id = id;
+        const typename map_type::const_iterator iValues( map_->find( id ) );
+        if ( iValues != map_->end() ) {
+          product.found  = true;
+          product.size   = iValues.size();
+          product.values = iValues.begin();
+        }
+        products_.push_back( product );
+        return products_.back();
+      }
+
+      edm::Handle< map_type >         map_;
+      mutable std::vector< Product >  products_;
+
+  };
+
+}
+
+
+#endif
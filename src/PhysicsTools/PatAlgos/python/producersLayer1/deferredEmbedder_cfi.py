@@ -0,0 +1,40 @@
+import FWCore.ParameterSet.Config as cms
+
+# Deferred embedding of AOD items into selected PAT leptons
+#
+# Usage: switch off the corresponding 'embed...' flags of 'patElectrons' and 'patMuons'
+# (only references are stored then), select the objects, and run these modules on the
+# selected collections, before the output module.
+# The flags have the same meaning as in the PAT producers; the referenced AOD items
+# have to be available in the job.
+
+patElectronsDeferredEmbedding = cms.EDProducer("PATElectronDeferredEmbedder",
+    src = cms.InputTag("selectedPatElectrons"),
+
+    embedGsfElectronCore        = cms.bool(True),  ## embed in AOD externally stored gsf electron core
+    embedGsfTrack               = cms.bool(True),  ## embed in AOD externally stored gsf track
+    embedSuperCluster           = cms.bool(True),  ## embed in AOD externally stored supercluster
+    embedPflowSuperCluster      = cms.bool(True),  ## embed in AOD externally stored supercluster
+    embedSeedCluster            = cms.bool(True),  ## embed in AOD externally stored the electron's seedcluster
+    embedBasicClusters          = cms.bool(True),  ## embed in AOD externally stored the electron's basic clusters
+    embedPreshowerClusters      = cms.bool(True),  ## embed in AOD externally stored the electron's preshower clusters
+    embedPflowBasicClusters     = cms.bool(True),  ## embed in AOD externally stored the electron's pflow basic clusters
+    embedPflowPreshowerClusters = cms.bool(True),  ## embed in AOD externally stored the electron's pflow preshower clusters
+    embedPFCandidate            = cms.bool(True),  ## embed in AOD externally stored particle flow candidate
+    embedTrack                  = cms.bool(True),  ## embed in AOD externally stored track (note: gsf electrons don't have a track)
+    embedGenMatch               = cms.bool(True)   ## embed the matched generator particle
+)
+
+patMuonsDeferredEmbedding = cms.EDProducer("PATMuonDeferredEmbedder",
+    src = cms.InputTag("selectedPatMuons"),
+
+    embedMuonBestTrack  = cms.bool(True),  ## embed in AOD externally stored muon best track
+    embedTrack          = cms.bool(False), ## embed in AOD externally stored tracker track
+    embedCombinedMuon   = cms.bool(True),  ## embed in AOD externally stored combined muon track
+    embedStandAloneMuon = cms.bool(True),  ## embed in AOD externally stored standalone muon track
+    embedPickyMuon      = cms.bool(True),  ## embed in AOD externally stored TeV-refit picky muon track
+    embedTpfmsMuon      = cms.bool(True),  ## embed in AOD externally stored TeV-refit TPFMS muon track
+    embedDytMuon        = cms.bool(True),  ## embed in AOD externally stored TeV-refit DYT muon track
+    embedPFCandidate    = cms.bool(True),  ## embed in AOD externally stored particle flow candidate
+    embedGenMatch       = cms.bool(True)   ## embed the matched generator particle
+)
@@ -0,0 +1,18 @@
+import FWCore.ParameterSet.Config as cms
+
+# Packing of the PAT stand-alone trigger objects for compact output
+#
+# Usage: keep '*_patTriggerPacked_*_*' instead of '*_patTrigger_*_*' in the output;
+# this keeps the packed objects per event and their name tables per run.
+# In a later job, 'patTriggerUnpacked' restores the pat::TriggerObjectStandAloneCollection.
+# The unpacked objects are a new product: existing trigger matches and pat::TriggerEvent
+# references still point to the original 'patTrigger' product, so the PAT trigger matching
+# has to be rerun with 'patTriggerUnpacked' as input.
+
+patTriggerPacked = cms.EDProducer( "PATTriggerObjectStandAlonePacker"
+, src = cms.InputTag( "patTrigger" )
+)
+
+patTriggerUnpacked = cms.EDProducer( "PATTriggerObjectStandAloneUnpacker"
+, src = cms.InputTag( "patTriggerPacked" )
+)
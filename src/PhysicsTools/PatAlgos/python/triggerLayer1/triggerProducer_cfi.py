@@ -15,6 +15,7 @@ patTrigger = cms.EDProducer( "PATTriggerProducer"
 # , l1ExtraHTM                     = cms.InputTag( "l1extraParticles", "MHT"         ) # default; change only, if you know exactly, what you are doing!
 # , mainBxOnly                     = cms.bool( True )                                  # default
 # , saveL1Refs                     = cms.bool( False )                                 # default; setting this to True requires to keep '*_l1extraParticles_*_[processName]' and '*_gctDigis_*_[processName]' in the event
+# , l1ExtraConcurrent              = cms.bool( False )                                 # default; setting this to True converts the l1extra collections concurrently
 ## HLT (L3)
 , processName    = cms.string( "HLT" )                    # default; change only, if you know exactly, what you are doing!
 # , triggerResults = cms.InputTag( "TriggerResults" )       # default; change only, if you know exactly, what you are doing!
@@ -0,0 +1,122 @@
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Utilities/interface/InputTag.h"
+#include "FWCore/Framework/interface/EDAnalyzer.h"
+#include "FWCore/Framework/interface/Frameworkfwd.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+
+#include "TStopwatch.h"
+
+
+/// Compares the embedded trigger match access of pat::Muons by value ('triggerObjectMatchesByPath')
+/// with the non-copying access by indices ('triggerObjectMatchIndicesByPath') for a multi-path selection
+class PatTriggerMatchBenchmark : public edm::EDAnalyzer {
+
+ public:
+  /// default constructor
+  explicit PatTriggerMatchBenchmark( const edm::ParameterSet & iConfig );
+  /// default destructor
+  ~PatTriggerMatchBenchmark(){};
+
+ private:
+  /// everything that needs to be done before the event loop
+  virtual void beginJob();
+  /// everything that needs to be done during the event loop
+  virtual void analyze( const edm::Event & iEvent, const edm::EventSetup & iSetup );
+  /// everything that needs to be done after the event loop
+  virtual void endJob();
+
+  /// input for muons with embedded trigger matches
+  edm::InputTag muons_;
+  /// HLT path names to select on
+  std::vector< std::string > pathNames_;
+  /// number of repetitions of the selection per event
+  unsigned repetitions_;
+
+  /// timers for both access modes
+  TStopwatch timerCopy_;
+  TStopwatch timerIndices_;
+  /// counters
+  unsigned long nMuons_;
+  unsigned long nMatchesCopy_;
+  unsigned long nMatchesIndices_;
+  /// sum of matched trigger object pt, to cross-check both modes
+  double sumPtCopy_;
+  double sumPtIndices_;
+
+};
+
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+
+#include "DataFormats/PatCandidates/interface/Muon.h"
+
+
+using namespace pat;
+
+
+PatTriggerMatchBenchmark::PatTriggerMatchBenchmark( const edm::ParameterSet & iConfig )
+: muons_( iConfig.getParameter< edm::InputTag >( "muons" ) )
+, pathNames_( iConfig.getParameter< std::vector< std::string > >( "pathNames" ) )
+, repetitions_( iConfig.getUntrackedParameter< unsigned >( "repetitions", 1 ) )
+, nMuons_( 0 )
+, nMatchesCopy_( 0 )
+, nMatchesIndices_( 0 )
+, sumPtCopy_( 0. )
+, sumPtIndices_( 0. )
+{
+}
+
+void PatTriggerMatchBenchmark::beginJob()
+{
+  timerCopy_.Reset();
+  timerIndices_.Reset();
+}
+
+void PatTriggerMatchBenchmark::analyze( const edm::Event & iEvent, const edm::EventSetup & iSetup )
+{
+  // PAT muons with embedded trigger matches
+  edm::Handle< MuonCollection > muons;
+  iEvent.getByLabel( muons_, muons );
+  nMuons_ += muons->size();
+
+  // access by value
+  timerCopy_.Start( kFALSE );
+  for ( unsigned iR = 0; iR < repetitions_; ++iR ) {
+    for ( MuonCollection::const_iterator iMuon = muons->begin(); iMuon != muons->end(); ++iMuon ) {
+      for ( std::vector< std::string >::const_iterator iPath = pathNames_.begin(); iPath != pathNames_.end(); ++iPath ) {
+        const TriggerObjectStandAloneCollection matches( iMuon->triggerObjectMatchesByPath( *iPath ) );
+        for ( TriggerObjectStandAloneCollection::const_iterator iMatch = matches.begin(); iMatch != matches.end(); ++iMatch ) {
+          ++nMatchesCopy_;
+          sumPtCopy_ += iMatch->pt();
+        }
+      }
+    }
+  }
+  timerCopy_.Stop();
+
+  // access by indices
+  timerIndices_.Start( kFALSE );
+  for ( unsigned iR = 0; iR < repetitions_; ++iR ) {
+    for ( MuonCollection::const_iterator iMuon = muons->begin(); iMuon != muons->end(); ++iMuon ) {
+      for ( std::vector< std::string >::const_iterator iPath = pathNames_.begin(); iPath != pathNames_.end(); ++iPath ) {
+        const std::vector< size_t > indices( iMuon->triggerObjectMatchIndicesByPath( *iPath ) );
+        for ( std::vector< size_t >::const_iterator iMatch = indices.begin(); iMatch != indices.end(); ++iMatch ) {
+          ++nMatchesIndices_;
+          sumPtIndices_ += iMuon->triggerObjectMatches()[ *iMatch ].pt();
+        }
+      }
+    }
+  }
+  timerIndices_.Stop();
+}
+
+void PatTriggerMatchBenchmark::endJob()
+{
+  edm::LogVerbatim( "PatTriggerMatchBenchmark" ) << "PatTriggerMatchBenchmark: " << nMuons_ << " muons, " << pathNames_.size() << " paths, " << repetitions_ << " repetition(s)\n"
+                                                 << "  by value  : " << nMatchesCopy_    << " matches (sum pt " << sumPtCopy_    << "), CPU " << timerCopy_.CpuTime()    << " s\n"
+                                                 << "  by indices: " << nMatchesIndices_ << " matches (sum pt " << sumPtIndices_ << "), CPU " << timerIndices_.CpuTime() << " s";
+  if ( nMatchesCopy_ != nMatchesIndices_ || sumPtCopy_ != sumPtIndices_ ) edm::LogError( "PatTriggerMatchBenchmark" ) << "Access modes disagree";
+}
+
+
+#include "FWCore/Framework/interface/MakerMacros.h"
+DEFINE_FWK_MODULE( PatTriggerMatchBenchmark );
@@ -0,0 +1,188 @@
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Utilities/interface/InputTag.h"
+#include "FWCore/Framework/interface/EDAnalyzer.h"
+#include "FWCore/Framework/interface/Frameworkfwd.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "DataFormats/PatCandidates/interface/PackedTriggerObjectStandAlone.h"
+
+#include "TStopwatch.h"
+
+#include <memory>
+
+
+/// Compares the pat::TriggerObjectStandAloneCollection with its packed representation
+/// (pat::PackedTriggerObjectStandAloneCollection) in streamed size and packing/unpacking speed;
+/// the name tables are collected per run as in the PATTriggerObjectStandAlonePacker
+class PatTriggerPackingBenchmark : public edm::EDAnalyzer {
+
+ public:
+  /// default constructor
+  explicit PatTriggerPackingBenchmark( const edm::ParameterSet & iConfig );
+  /// default destructor
+  ~PatTriggerPackingBenchmark(){};
+
+ private:
+  /// everything that needs to be done before the event loop
+  virtual void beginJob();
+  /// everything that needs to be done during the event loop
+  virtual void analyze( const edm::Event & iEvent, const edm::EventSetup & iSetup );
+  /// everything that needs to be done after each run
+  virtual void endRun( const edm::Run & iRun, const edm::EventSetup & iSetup );
+  /// everything that needs to be done after the event loop
+  virtual void endJob();
+
+  /// input for stand-alone trigger objects
+  edm::InputTag triggerObjects_;
+  /// number of repetitions of the packing and unpacking per event
+  unsigned repetitions_;
+
+  /// name table of the current run
+  std::auto_ptr< pat::PackedTriggerObjectStandAloneTable > table_;
+  /// timers
+  TStopwatch timerPack_;
+  TStopwatch timerUnpack_;
+  /// counters
+  unsigned long nEvents_;
+  unsigned long nObjects_;
+  unsigned long nMismatches_;
+  unsigned long nRuns_;
+  /// streamed sizes in bytes
+  double sizeStandAlone_;
+  double sizePacked_;
+  double sizeTables_;
+
+};
+
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+
+#include "DataFormats/Math/interface/deltaPhi.h"
+
+#include "TBufferFile.h"
+#include "TClass.h"
+
+#include <algorithm>
+#include <cmath>
+
+
+using namespace pat;
+
+
+namespace {
+
+  /// size of the object streamed with its ROOT dictionary
+  template< class T >
+  int streamedSize( const T & object )
+  {
+    TBufferFile buffer( TBuffer::kWrite );
+    buffer.WriteObjectAny( &object, TClass::GetClass( typeid( T ) ) );
+    return buffer.Length();
+  }
+
+  /// same names irrespective of their order (the unpacking orders them by the name tables)
+  bool sameNames( std::vector< std::string > orig, std::vector< std::string > copy )
+  {
+    std::sort( orig.begin(), orig.end() );
+    std::sort( copy.begin(), copy.end() );
+    return orig == copy;
+  }
+
+  /// same object within the packing precision:
+  /// pt and mass as float, eta to 1e-3, phi to 1e-4, everything else exactly
+  bool sameObject( const TriggerObjectStandAlone & orig, const TriggerObjectStandAlone & copy )
+  {
+    if ( float( orig.pt() ) != float( copy.pt() ) || float( orig.mass() ) != float( copy.mass() ) ) return false;
+    if ( std::abs( orig.eta() - copy.eta() ) > 1.e-3 || std::abs( reco::deltaPhi( orig.phi(), copy.phi() ) ) > 1.e-4 ) return false;
+    if ( orig.charge() != copy.charge() || orig.pdgId() != copy.pdgId() ) return false;
+    if ( orig.collection() != copy.collection() || orig.filterIds() != copy.filterIds() ) return false;
+    if ( ! sameNames( orig.filterLabels(), copy.filterLabels() ) ) return false;
+    if ( ! sameNames( orig.pathNames( false, false ), copy.pathNames( false, false ) ) ) return false;
+    if ( ! sameNames( orig.pathNames( true, false ), copy.pathNames( true, false ) ) ) return false;
+    if ( ! sameNames( orig.pathNames( false, true ), copy.pathNames( false, true ) ) ) return false;
+    return true;
+  }
+
+}
+
+
+PatTriggerPackingBenchmark::PatTriggerPackingBenchmark( const edm::ParameterSet & iConfig )
+: triggerObjects_( iConfig.getParameter< edm::InputTag >( "triggerObjects" ) )
+, repetitions_( iConfig.getUntrackedParameter< unsigned >( "repetitions", 1 ) )
+, nEvents_( 0 )
+, nObjects_( 0 )
+, nMismatches_( 0 )
+, nRuns_( 0 )
+, sizeStandAlone_( 0. )
+, sizePacked_( 0. )
+, sizeTables_( 0. )
+{
+}
+
+void PatTriggerPackingBenchmark::beginJob()
+{
+  timerPack_.Reset();
+  timerUnpack_.Reset();
+}
+
+void PatTriggerPackingBenchmark::analyze( const edm::Event & iEvent, const edm::EventSetup & iSetup )
+{
+  // PAT stand-alone trigger objects
+  edm::Handle< TriggerObjectStandAloneCollection > triggerObjects;
+  iEvent.getByLabel( triggerObjects_, triggerObjects );
+  ++nEvents_;
+  nObjects_ += triggerObjects->size();
+
+  // packing
+  if ( table_.get() == 0 ) table_.reset( new PackedTriggerObjectStandAloneTable( iEvent.luminosityBlock(), iEvent.id().event() ) );
+  timerPack_.Start( kFALSE );
+  PackedTriggerObjectStandAloneCollection packed;
+  for ( unsigned iR = 0; iR < repetitions_; ++iR ) {
+    packed = PackedTriggerObjectStandAloneCollection( *triggerObjects, *table_ );
+  }
+  timerPack_.Stop();
+
+  // unpacking
+  timerUnpack_.Start( kFALSE );
+  TriggerObjectStandAloneCollection unpacked;
+  for ( unsigned iR = 0; iR < repetitions_; ++iR ) {
+    unpacked = packed.unpack( *table_ );
+  }
+  timerUnpack_.Stop();
+
+  // sizes
+  sizeStandAlone_ += streamedSize( *triggerObjects );
+  sizePacked_     += streamedSize( packed );
+
+  // closure within the packing precision
+  if ( unpacked.size() != triggerObjects->size() ) {
+    nMismatches_ += triggerObjects->size();
+    return;
+  }
+  for ( size_t iObj = 0; iObj < triggerObjects->size(); ++iObj ) {
+    if ( ! sameObject( triggerObjects->at( iObj ), unpacked.at( iObj ) ) ) ++nMismatches_;
+  }
+}
+
+void PatTriggerPackingBenchmark::endRun( const edm::Run & iRun, const edm::EventSetup & iSetup )
+{
+  if ( table_.get() == 0 ) return;
+  ++nRuns_;
+  PackedTriggerObjectStandAloneTables tables;
+  tables.add( *table_ );
+  sizeTables_ += streamedSize( tables );
+  table_.reset();
+}
+
+void PatTriggerPackingBenchmark::endJob()
+{
+  if ( nEvents_ == 0 ) return;
+  edm::LogVerbatim( "PatTriggerPackingBenchmark" ) << "PatTriggerPackingBenchmark: " << nEvents_ << " events, " << nObjects_ << " trigger objects, " << repetitions_ << " repetition(s)\n"
+                                                   << "  streamed size per event: stand-alone " << sizeStandAlone_ / nEvents_ << " bytes, packed " << sizePacked_ / nEvents_ << " bytes\n"
+                                                   << "  streamed size of the name tables: " << sizeTables_ << " bytes in " << nRuns_ << " run(s), " << sizeTables_ / nEvents_ << " bytes per event\n"
+                                                   << "  packing  : CPU " << timerPack_.CpuTime()   << " s\n"
+                                                   << "  unpacking: CPU " << timerUnpack_.CpuTime() << " s";
+  if ( nMismatches_ > 0 ) edm::LogError( "PatTriggerPackingBenchmark" ) << nMismatches_ << " trigger objects differ after unpacking";
+}
+
+
+#include "FWCore/Framework/interface/MakerMacros.h"
+DEFINE_FWK_MODULE( PatTriggerPackingBenchmark );
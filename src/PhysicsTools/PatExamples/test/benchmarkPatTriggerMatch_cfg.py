@@ -0,0 +1,38 @@
+import FWCore.ParameterSet.Config as cms
+
+process = cms.Process( "TEST" )
+
+process.load( "FWCore.MessageService.MessageLogger_cfi" )
+process.MessageLogger.categories.append( 'PatTriggerMatchBenchmark' )
+process.options = cms.untracked.PSet(
+    wantSummary = cms.untracked.bool( True )
+)
+
+## PAT tuple with embedded muon trigger matches,
+## e.g. from 'producePatTrigger_cfg.py' with 'switchOnTriggerMatchEmbedding( process, triggerMatchers = [ 'muonTriggerMatchHLTMuons' ] )'
+process.source = cms.Source( "PoolSource",
+    fileNames = cms.untracked.vstring(
+        'file:patTuple.root'
+    )
+)
+process.maxEvents = cms.untracked.PSet(
+    input = cms.untracked.int32( -1 )
+)
+
+process.triggerMatchBenchmark = cms.EDAnalyzer( "PatTriggerMatchBenchmark",
+    muons     = cms.InputTag( "selectedPatMuonsTriggerMatch" ),
+    pathNames = cms.vstring( 'HLT_IsoMu24_eta2p1_v*'
+                           , 'HLT_IsoMu24_v*'
+                           , 'HLT_IsoMu30_eta2p1_v*'
+                           , 'HLT_Mu40_eta2p1_v*'
+                           , 'HLT_Mu17_Mu8_v*'
+                           , 'HLT_Mu17_TkMu8_v*'
+                           , 'HLT_Mu13_Mu8_v*'
+                           , 'HLT_DoubleMu7_v*'
+                           ),
+    repetitions = cms.untracked.uint32( 10 )
+)
+
+process.p = cms.Path(
+    process.triggerMatchBenchmark
+)
@@ -0,0 +1,29 @@
+import FWCore.ParameterSet.Config as cms
+
+process = cms.Process( "TEST" )
+
+process.load( "FWCore.MessageService.MessageLogger_cfi" )
+process.MessageLogger.categories.append( 'PatTriggerPackingBenchmark' )
+process.options = cms.untracked.PSet(
+    wantSummary = cms.untracked.bool( True )
+)
+
+## PAT tuple with stand-alone trigger objects,
+## e.g. from 'producePatTrigger_cfg.py'
+process.source = cms.Source( "PoolSource",
+    fileNames = cms.untracked.vstring(
+        'file:patTuple.root'
+    )
+)
+process.maxEvents = cms.untracked.PSet(
+    input = cms.untracked.int32( -1 )
+)
+
+process.triggerPackingBenchmark = cms.EDAnalyzer( "PatTriggerPackingBenchmark",
+    triggerObjects = cms.InputTag( "patTrigger" ),
+    repetitions    = cms.untracked.uint32( 10 )
+)
+
+process.p = cms.Path(
+    process.triggerPackingBenchmark
+)
@@ -50,6 +50,9 @@ maxDR = 0.1
 #fitRange = 1. # for Gaussian fits (in sigma)
 #fitRange = 2. # for Gaussian fits (in sigma)
 fitRange = histMax # for Gaussian fits (in sigma)
+closureTolerance = 1.e-4 # max. abs. error of the tabulated transfer functions for the closure test (0.: no closure pulls)
+closureThreads   = 0     # threads for the closure test (0: default, 1: serial)
+closureSeed      = 4357  # seed of the random number streams for the smears
 
 # I/O
 name = ''
@@ -155,6 +158,9 @@ process.transferPull = cms.PSet(
   doFit       = cms.bool( doFit )
 , fitOptions  = cms.string( 'IBRS+' )
 , fitRange    = cms.double( fitRange )
+, closureTolerance = cms.double( closureTolerance )
+, closureThreads   = cms.uint32( closureThreads )
+, closureSeed      = cms.uint32( closureSeed )
 )
 
 
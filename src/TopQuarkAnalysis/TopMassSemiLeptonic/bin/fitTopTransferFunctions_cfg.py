@@ -64,6 +64,10 @@ fitRange    = 1. # for Gaussian fits (in units of orig. RMS)
 #fitRange    = 2. # for Gaussian fits (in units of orig. RMS)
 if fitFunction != 'sGauss': # a background function is defined
   fitRange = widthFactor # for combined fits (in units of orig. RMS)
+fitUnbinned = False # additional unbinned likelihood fits of the restricted (eta, p_t) cells
+fitThreads  = 0     # threads for the unbinned fits (0: default, 1: serial)
+fitJoint    = False # joint unbinned fits of the p_t dependence, replacing the restricted per-bin and dependency fits (only with norm = 0)
+tableTolerance = 0. # max. abs. error of the lookup tables of the restricted transfer functions (0.: no tables)
 
 # I/O
 name = ''
@@ -156,6 +160,10 @@ process.transfer = cms.PSet(
 , fitOptions  = cms.string( fitOptions )
 , fitRange    = cms.double( fitRange )
 , dependencyFunction = cms.string( dependencyFunction )
+, fitUnbinned = cms.bool( fitUnbinned )
+, fitThreads  = cms.uint32( fitThreads )
+, fitJoint    = cms.bool( fitJoint )
+, tableTolerance = cms.double( tableTolerance )
 , pathOut     = cms.string( pathOut )
 )
 
@@ -0,0 +1,102 @@
+#ifndef TopQuarkPhysics_TopMassSemiLeptonic_InputFileIndex_h
+#define TopQuarkPhysics_TopMassSemiLeptonic_InputFileIndex_h
+
+
+// -*- C++ -*-
+//
+// Package:    TopMassSemiLeptonic
+// Class:      my::InputFileIndex
+//
+// $Id:$
+//
+/**
+  \class    my::InputFileIndex InputFileIndex.h "TopQuarkAnalsyis/TopMassSemiLeptonic/interface/InputFileIndex.h"
+  \brief    Input layer of the fit, closure and plot macros: indexes the directory tree of a ROOT file and caches its objects
+
+   my::InputFileIndex opens one file and walks the directory tree below
+   'top' once, recording all keys (with and without cycle number) per
+   directory. The directories themselves are read during this walk.
+   Objects are then handed out via Get( directory, name ), which replaces
+   'directory->Get( name )': names missing in the index return 0 without
+   any file access, found objects are read once and returned from a cache
+   afterwards. Directories which are not indexed (e.g. created after the
+   indexing) are passed on to TDirectory::Get(). Objects handed out must
+   not be deleted directly, but via Delete().
+   The file is owned and closed by the caller.
+
+  \author   Volker Adler
+  \version  $Id:$
+*/
+
+
+#include <map>
+#include <string>
+
+#include <TFile.h>
+#include <TDirectory.h>
+
+
+namespace my {
+
+  class InputFileIndex {
+
+    public:
+
+      /// Key names (with and without ";<cycle>") and their class names of a directory
+      typedef std::map< std::string, std::string > KeyIndex;
+
+    private:
+
+      ///
+      /// Data Members
+      ///
+
+      /// Indexed file; 0, if it could not be opened
+      TFile * file_;
+
+      /// Key index per indexed directory
+      std::map< const TDirectory *, KeyIndex > keys_;
+
+      /// Objects read so far per directory
+      std::map< const TDirectory *, std::map< std::string, TObject * > > objects_;
+
+    public:
+
+      ///
+      /// Constructors and Desctructor
+      ///
+
+      /// Constructor from a file name
+      /// Opens the file with 'option' and indexes the directory 'top' (e.g. an event
+      /// selection, all if empty).
+      InputFileIndex( const std::string & fileName, const std::string & option = "READ", const std::string & top = "" );
+
+      /// Destructor
+      virtual ~InputFileIndex() {};
+
+      ///
+      /// Methods
+      ///
+
+      /// Getters
+
+      /// Get the file; 0, if it could not be opened.
+      TFile * File() const { return file_; };
+
+      /// Objects
+
+      /// Get the object 'name' (possibly with ";<cycle>") of directory 'dir'.
+      TObject * Get( TDirectory * dir, const std::string & name );
+
+      /// Get the sub-directory 'name' of directory 'dir'.
+      TDirectory * GetDirectory( TDirectory * dir, const std::string & name ) { return dynamic_cast< TDirectory * >( Get( dir, name ) ); };
+
+      /// Removes the object 'name' of directory 'dir' from the cache and deletes it.
+      void Delete( TDirectory * dir, const std::string & name );
+
+  };
+
+}
+
+
+#endif
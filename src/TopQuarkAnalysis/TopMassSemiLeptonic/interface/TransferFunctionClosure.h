@@ -0,0 +1,127 @@
+#ifndef TopQuarkPhysics_TopMassSemiLeptonic_TransferFunctionClosure_h
+#define TopQuarkPhysics_TopMassSemiLeptonic_TransferFunctionClosure_h
+
+
+// -*- C++ -*-
+//
+// Package:    TopMassSemiLeptonic
+// Class:      my::TransferFunctionClosure
+//
+// $Id:$
+//
+/**
+  \class    my::TransferFunctionClosure TransferFunctionClosure.h "TopQuarkAnalsyis/TopMassSemiLeptonic/interface/TransferFunctionClosure.h"
+  \brief    Closure test engine: smears and pulls of many entries with a tabulated transfer function
+
+   my::TransferFunctionClosure computes the pulls
+     ( reference - non-reference - smear ) / sigma
+   of the closure test, where 'smear' is drawn from the transfer function at
+   the reference value and 'sigma' is the RMS of the transfer function there.
+   The transfer function is given as my::TransferFunctionTable. Smears are
+   drawn by acceptance-rejection in batches, so that the table is always
+   evaluated for many points at once. The RMS follows exactly from the
+   tabulated (piece-wise linear) function.
+   The entries are processed in fixed blocks of 'blockSize' entries, each
+   with its own random number stream (depending only on the seed, the stream
+   number given and the block number), and the blocks are distributed over
+   threads. The results are thus identical for any number of threads.
+
+  \author   Volker Adler
+  \version  $Id:$
+*/
+
+
+#include <vector>
+
+#include "TopQuarkAnalysis/TopMassSemiLeptonic/interface/TransferFunctionTable.h"
+
+
+namespace my {
+
+  /// Constants
+
+  /// Pull of entries, for which the transfer function vanishes
+  /// (no smear can be drawn)
+  static const double transferFunctionClosureInvalid( -999999. );
+
+  class TransferFunctionClosure {
+
+    public:
+
+      /// Number of entries per random number stream
+      static const unsigned blockSize = 1024;
+
+    private:
+
+      ///
+      /// Data Members
+      ///
+
+      /// Tabulated transfer function
+      TransferFunctionTable table_;
+
+      /// Integrals of 1, x and x^2 times the tabulated function over the fit
+      /// variable per node of the dependency axis
+      std::vector< double > moment0_;
+      std::vector< double > moment1_;
+      std::vector< double > moment2_;
+
+      /// Maximum of the tabulated function per node of the dependency axis
+      std::vector< double > maximum_;
+
+      /// Seed of the random number streams
+      unsigned seed_;
+
+    public:
+
+      ///
+      /// Constructors and Desctructor
+      ///
+
+      /// Constructor from TransferFunctionTable
+      TransferFunctionClosure( const TransferFunctionTable & table, unsigned seed = 4357 );
+
+      /// Destructor
+      virtual ~TransferFunctionClosure() {};
+
+      ///
+      /// Methods
+      ///
+
+      /// Getters
+
+      /// Get the tabulated transfer function.
+      const TransferFunctionTable & Table() const { return table_; };
+
+      /// Get the seed of the random number streams.
+      unsigned Seed() const { return seed_; };
+
+      /// Evaluate
+
+      /// Get the RMS of the transfer function for a given value of the
+      /// dependency variable; 0., if the function vanishes there.
+      double Sigma( double dependencyValue ) const;
+
+      /// Computes the pulls of 'n' entries into 'pulls' using 'nThreads'
+      /// threads (0: default, 1: serial).
+      /// Different 'stream' numbers give independent random numbers for the
+      /// same seed. Entries, for which no smear can be drawn, get the pull
+      /// 'transferFunctionClosureInvalid'.
+      void Pulls( unsigned n, const double * refValues, const double * nonRefValues, double * pulls, unsigned stream = 0, unsigned nThreads = 0 ) const;
+
+      /// Computes the pulls of one block of entries with its random number
+      /// stream (as used by Pulls()).
+      void PullsBlock( unsigned n, const double * refValues, const double * nonRefValues, double * pulls, unsigned stream, unsigned block ) const;
+
+    private:
+
+      /// Interpolation position along the dependency axis (as in
+      /// TransferFunctionTable::Eval())
+      void Position( double dependencyValue, unsigned & node, double & fraction ) const;
+
+  };
+
+}
+
+
+#endif
@@ -0,0 +1,170 @@
+#ifndef TopQuarkPhysics_TopMassSemiLeptonic_TransferFunctionTable_h
+#define TopQuarkPhysics_TopMassSemiLeptonic_TransferFunctionTable_h
+
+
+// -*- C++ -*-
+//
+// Package:    TopMassSemiLeptonic
+// Class:      my::TransferFunctionTable
+//
+// $Id:$
+//
+/**
+  \class    my::TransferFunctionTable TransferFunctionTable.h "TopQuarkAnalsyis/TopMassSemiLeptonic/interface/TransferFunctionTable.h"
+  \brief    Tabulated 2-D transfer function for fast evaluation
+
+   my::TransferFunctionTable samples a my::TransferFunction on a grid in the
+   dependency and the fit variable and evaluates it by bilinear
+   interpolation.
+   The grid starts coarse and is refined (the number of intervals doubled)
+   along the axis with the larger interpolation error, until the maximum
+   absolute error at the cell and edge midpoints is below the requested
+   tolerance. Both axes are equidistant, so the cell of a point is found
+   arithmetically without any search.
+
+  \author   Volker Adler
+  \version  $Id:$
+*/
+
+
+#include <vector>
+#include <string>
+#include <iostream>
+#include <algorithm>
+
+#include "TopQuarkAnalysis/TopMassSemiLeptonic/interface/TransferFunction.h"
+
+
+namespace my {
+
+  class TransferFunctionTable {
+
+      ///
+      /// Data Members
+      ///
+
+      /// Dependency axis: lower edge, node distance and its inverse, number of nodes
+      double dependencyMin_;
+      double dependencyStep_;
+      double dependencyScale_;
+      unsigned nDependency_;
+
+      /// Fit variable axis: lower edge, node distance and its inverse, number of nodes
+      double valueMin_;
+      double valueStep_;
+      double valueScale_;
+      unsigned nValue_;
+
+      /// Tabulated function values
+      /// Stored as [ iDependency * nValue_ + iValue ].
+      std::vector< double > table_;
+
+      /// Maximum absolute deviation from the analytic function found at the
+      /// cell and edge midpoints of the final grid
+      double maxError_;
+
+    public:
+
+      ///
+      /// Constructors and Desctructor
+      ///
+
+      /// Default constructor (empty table)
+      TransferFunctionTable();
+
+      /// Constructor from TransferFunction
+      /// Tabulates 'transfer.Eval( dependencyValue, value, norm )' for
+      /// 'dependencyMin' <= dependencyValue <= 'dependencyMax' and 'valueMin'
+      /// <= value <= 'valueMax'. The grid is refined until the maximum
+      /// absolute error is below 'tolerance' or the number of nodes would
+      /// exceed 'maxNodes'.
+      TransferFunctionTable( const TransferFunction & transfer, double dependencyMin, double dependencyMax, double valueMin, double valueMax, double tolerance, int norm = 0, unsigned maxNodes = 1 << 20 );
+
+      /// Destructor
+      virtual ~TransferFunctionTable() {};
+
+      ///
+      /// Methods
+      ///
+
+      /// Getters
+
+      /// Is the table filled?
+      bool Empty() const { return table_.empty(); };
+
+      /// Get the number of nodes along the dependency axis.
+      unsigned NNodesDependency() const { return nDependency_; };
+
+      /// Get the number of nodes along the fit variable axis.
+      unsigned NNodesValue() const { return nValue_; };
+
+      /// Get the range of the dependency variable.
+      double DependencyMin() const { return dependencyMin_; };
+      double DependencyMax() const { return dependencyMin_ + ( nDependency_ - 1 ) * dependencyStep_; };
+
+      /// Get the range of the fit variable.
+      double ValueMin() const { return valueMin_; };
+      double ValueMax() const { return valueMin_ + ( nValue_ - 1 ) * valueStep_; };
+
+      /// Get a tabulated function value.
+      double Node( unsigned iDependency, unsigned iValue ) const { return table_[ iDependency * nValue_ + iValue ]; };
+
+      /// Get the maximum absolute approximation error with respect to the
+      /// analytic function (s. data members).
+      double MaxError() const { return maxError_; };
+
+      /// Evaluate
+
+      /// Get the interpolated value for given values of the dependency and
+      /// fit variables.
+      /// Dependency values outside the table are moved to its border; for
+      /// fit variable values outside the table 0. is returned.
+      inline double Eval( double dependencyValue, double value ) const;
+
+      /// Evaluate 'n' points at once into 'results'.
+      void Eval( unsigned n, const double * dependencyValues, const double * values, double * results ) const;
+
+      /// Communication
+
+      /// Writes the table in a text format, which can be read back by Read().
+      void Write( std::ostream & stream ) const;
+
+      /// Creates a table from the text format as written by Write().
+      /// Returns an empty table in case of error.
+      static TransferFunctionTable Read( std::istream & stream );
+
+    private:
+
+      /// Sets the axes
+      void SetAxes( double dependencyMin, double dependencyMax, unsigned nDependency, double valueMin, double valueMax, unsigned nValue );
+
+  };
+
+
+  /// Collection of TransferFunctionTable
+  typedef std::vector< TransferFunctionTable > TransferFunctionTableCollection;
+
+
+  /// Inline methods
+
+  double TransferFunctionTable::Eval( double dependencyValue, double value ) const
+  {
+    if ( table_.empty() ) return 0.;
+    const double u( ( value - valueMin_ ) * valueScale_ );
+    if ( ! ( u >= 0. && u <= ( double )( nValue_ - 1 ) ) ) return 0.;
+    double t( ( dependencyValue - dependencyMin_ ) * dependencyScale_ );
+    if ( ! ( t > 0. ) ) t = 0.;
+    if ( t > ( double )( nDependency_ - 1 ) ) t = ( double )( nDependency_ - 1 );
+    const unsigned iDependency( std::min( ( unsigned )t, nDependency_ - 2 ) );
+    const unsigned iValue( std::min( ( unsigned )u, nValue_ - 2 ) );
+    const double ft( t - iDependency );
+    const double fu( u - iValue );
+    const double * low( &table_[ iDependency * nValue_ + iValue ] );
+    const double * high( low + nValue_ );
+    return ( 1. - ft ) * ( ( 1. - fu ) * low[ 0 ] + fu * low[ 1 ] ) + ft * ( ( 1. - fu ) * high[ 0 ] + fu * high[ 1 ] );
+  }
+
+}
+
+
+#endif
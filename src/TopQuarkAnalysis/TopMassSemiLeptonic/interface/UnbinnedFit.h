@@ -0,0 +1,172 @@
+#ifndef TopQuarkPhysics_TopMassSemiLeptonic_UnbinnedFit_h
+#define TopQuarkPhysics_TopMassSemiLeptonic_UnbinnedFit_h
+
+
+// -*- C++ -*-
+//
+// Package:    TopMassSemiLeptonic
+// Class:      my::UnbinnedFitter
+//
+// $Id:$
+//
+/**
+  \class    my::UnbinnedFitter UnbinnedFit.h "TopQuarkAnalsyis/TopMassSemiLeptonic/interface/UnbinnedFit.h"
+  \brief    Unbinned maximum likelihood fits of my::Function shapes to weighted samples
+
+   my::UnbinnedFitter fits the shape of a my::Function (my::Resolution), whose
+   parameter [0] is the normalisation factor, directly to the weighted entries
+   of a fit cell (my::UnbinnedSample) within the cell's fit range.
+   The shape is normalised numerically over the fit range, so the
+   normalisation factor is not a free parameter of the likelihood; it is
+   reported as the sum of weights extrapolated to the full shape.
+   The minimisation uses Minuit2 with the analytic gradients of the function.
+
+   my::fitUnbinnedGrid() fits a grid of cells (e.g. eta x p_t): the rows are
+   fitted in parallel, the cells of a row in order, each starting from the
+   converged parameters of its predecessor.
+
+   my::UnbinnedDependencyFitter determines the coefficients of the dependency
+   function (my::TransferFunction::Parameters2D()) in one step from all cells
+   simultaneously: the shape parameters of a cell are the dependency function
+   evaluated at the cell's dependency value (e.g. the mean p_t), and the sum of
+   the cells' negative log-likelihoods is minimised. A shape parameter depends
+   only on its own coefficients, so the Jacobian of the cell parameters is
+   block diagonal; the gradient is accumulated cell by cell from the shape and
+   dependency gradients without building it.
+   my::fitUnbinnedDependencyGrid() runs the joint fits of all rows and of the
+   full grid in parallel.
+   The HitFit resolution and L5(L7) executables do not use the unbinned fits
+   yet; they ignore a 'fitUnbinned' parameter with a warning.
+
+  \author   Volker Adler
+  \version  $Id:$
+*/
+
+
+#include <vector>
+
+#include "CommonTools/MyTools/interface/RootFunctions.h"
+
+
+namespace my {
+
+  /// Weighted entries of a fit cell and the fit range
+  struct UnbinnedSample {
+    UnbinnedSample() : min( 0. ), max( 0. ) {};
+    std::vector< Double_t > values;
+    std::vector< Double_t > weights;
+    Double_t min;
+    Double_t max;
+  };
+
+  /// Start values and limits of the fit parameters
+  /// Parameters with 'lower' >= 'upper' are not limited.
+  struct UnbinnedSeed {
+    std::vector< Double_t > values;
+    std::vector< Double_t > lower;
+    std::vector< Double_t > upper;
+  };
+
+  /// Result of an unbinned fit
+  struct UnbinnedFitResult {
+    UnbinnedFitResult() : status( -1 ), nll( 0. ) {};
+    /// Minuit2 status; -1: not fitted
+    Int_t status;
+    /// Negative log-likelihood at the minimum
+    Double_t nll;
+    std::vector< Double_t > parameters;
+    std::vector< Double_t > errors;
+  };
+
+  /// Result of a joint fit of the dependency function coefficients
+  struct UnbinnedDependencyFitResult {
+    UnbinnedDependencyFitResult() : status( -1 ), nll( 0. ), nCells( 0 ) {};
+    /// Minuit2 status; -1: not fitted
+    Int_t status;
+    /// Negative log-likelihood at the minimum
+    Double_t nll;
+    /// Number of cells used
+    UInt_t nCells;
+    /// Coefficient j of the dependency of fit parameter i as [ i ][ j ]
+    /// The normalisation (i = 0) is not fitted; its coefficients are 0.
+    std::vector< std::vector< Double_t > > coefficients;
+    std::vector< std::vector< Double_t > > errors;
+  };
+
+  typedef std::vector< std::vector< UnbinnedSample > >    UnbinnedSampleGrid;
+  typedef std::vector< std::vector< UnbinnedSeed > >      UnbinnedSeedGrid;
+  typedef std::vector< std::vector< UnbinnedFitResult > > UnbinnedFitResultGrid;
+  typedef std::vector< std::vector< Double_t > >          UnbinnedValueGrid;
+
+  class UnbinnedFitter {
+
+      /// Fitted function, not owned
+      Function * function_;
+
+      /// Number of intervals of the numerical normalisation (Simpson's rule)
+      UInt_t nIntegration_;
+
+    public:
+
+      /// Constructor from the function to fit
+      explicit UnbinnedFitter( Function * function, UInt_t nIntegration = 200 );
+
+      /// Fits the function to the sample, starting from 'seed'
+      UnbinnedFitResult Fit( const UnbinnedSample & sample, const UnbinnedSeed & seed ) const;
+
+  };
+
+  class UnbinnedDependencyFitter {
+
+      /// Fitted function, not owned
+      Function * function_;
+
+      /// Dependency function of the fit function parameters, not owned
+      Function * dependency_;
+
+      /// Range of dependency values of the cells to use
+      Double_t minDependency_;
+      Double_t maxDependency_;
+
+      /// Number of intervals of the numerical normalisation (Simpson's rule)
+      UInt_t nIntegration_;
+
+    public:
+
+      /// Constructor from the function to fit and the dependency function of its parameters
+      UnbinnedDependencyFitter( Function * function, Function * dependency, Double_t minDependency, Double_t maxDependency, UInt_t nIntegration = 200 );
+
+      /// Fits the dependency coefficients to the cells of a row
+      /// 'dependencyValues' holds the dependency value of each cell. The start values of
+      /// the coefficients are determined from the seed values of the cells.
+      /// Empty cells and cells outside the dependency range are skipped.
+      UnbinnedDependencyFitResult Fit( const std::vector< UnbinnedSample > & samples, const std::vector< Double_t > & dependencyValues, const std::vector< UnbinnedSeed > & seeds ) const;
+
+      /// Fits the dependency coefficients to all cells of a grid
+      UnbinnedDependencyFitResult Fit( const UnbinnedSampleGrid & samples, const UnbinnedValueGrid & dependencyValues, const UnbinnedSeedGrid & seeds ) const;
+
+    private:
+
+      UnbinnedDependencyFitResult Fit( const std::vector< const UnbinnedSample * > & samples, const std::vector< Double_t > & dependencyValues, const std::vector< const UnbinnedSeed * > & seeds ) const;
+
+  };
+
+  /// Creates a function of type 'FitFuncType' for a fit thread
+  template< typename FitFuncType >
+  Function * createFunction() { return new FitFuncType(); };
+
+  /// Fits all cells of 'samples', rows in parallel with 'nThreads' threads (0: default)
+  /// The cells of a row are fitted in order. A cell starts from its own seed, if the
+  /// previous cell's fit failed, and from the converged parameters of the previous
+  /// cell (within its own limits) otherwise.
+  UnbinnedFitResultGrid fitUnbinnedGrid( const UnbinnedSampleGrid & samples, const UnbinnedSeedGrid & seeds, Function * ( *create )(), unsigned nThreads = 0 );
+
+  /// Joint fits of the dependency coefficients with 'nThreads' threads (0: default)
+  /// Returns one result per row of 'samples', followed by the result of the joint fit
+  /// of all cells.
+  std::vector< UnbinnedDependencyFitResult > fitUnbinnedDependencyGrid( const UnbinnedSampleGrid & samples, const UnbinnedValueGrid & dependencyValues, const UnbinnedSeedGrid & seeds, Function * ( *createFit )(), Function * ( *createDependency )(), Double_t minDependency, Double_t maxDependency, unsigned nThreads = 0 );
+
+}
+
+
+#endif
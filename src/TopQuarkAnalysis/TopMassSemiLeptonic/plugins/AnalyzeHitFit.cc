@@ -9,7 +9,14 @@
   \class    AnalyzeHitFit AnalyzeHitFit.cc "TopQuarkAnalysis/TopMassSemiLeptonic/plugins/AnalyzeHitFit.cc"
   \brief    Fill histograms and n-tuples for HitFit resolution function determination
 
-
+   With 'columnBatchSize' > 0, the n-tuples per object category are written
+   column-wise: the objects of 'columnBatchSize' events are buffered in one
+   array per variable and written as one entry of vector branches to the tree
+   '<category>_columns' instead of one entry per object to '<category>_data'.
+   The branch names and the order of the objects are the same in both
+   layouts; my::readColumn() reads a full column from either, as the fit and
+   closure macros do.
+   Configurations without 'columnBatchSize' keep the row-wise layout.
 
   \author   Volker Adler
   \version  $Id: AnalyzeHitFit.cc,v 1.1 2011/08/31 14:45:53 vadler Exp $
@@ -100,6 +107,7 @@ class AnalyzeHitFit : public edm::EDAnalyzer {
     std::string jecLevel_;
     std::string pathPlots_;
     bool        plot_;
+    unsigned    columnBatchSize_;
     // Eta binning
     std::vector< std::vector< double > > etaBins_;
     std::vector< std::vector< double > > etaSymmBins_;
@@ -151,6 +159,14 @@ class AnalyzeHitFit : public edm::EDAnalyzer {
     Double_t phiGen_;
     Int_t    binEtaGen_;             // eta bin number as determined by 'getEtaBin'
     Int_t    binEtaSymmGen_;         // symmetrised eta bin number as determined by 'getEtaBin'
+    // columnar n-tuples
+    unsigned batchEvents_;                                                    // events buffered in the current batch
+    std::vector< std::vector< std::string > > catValueNames_;                // branch names of the floating point variables per object category
+    std::vector< std::vector< Double_t * > >  catValues_;                    // floating point variables per object category
+    std::vector< std::vector< std::string > > catBinNames_;                  // branch names of the integer variables per object category
+    std::vector< std::vector< Int_t * > >     catBins_;                      // integer variables per object category
+    std::vector< std::vector< std::vector< Double_t > > > catValueColumns_;  // buffers of the floating point variables
+    std::vector< std::vector< std::vector< Int_t > > >    catBinColumns_;    // buffers of the integer variables
 
     /// Histograms
     // Pile-up weights
@@ -164,14 +180,22 @@ class AnalyzeHitFit : public edm::EDAnalyzer {
 
     unsigned getEtaBin( unsigned iCat, double eta, bool symm = false );
 
+    // Book n-tuple branches per object category
+    void addBranch( unsigned iCat, const std::string & name, Double_t * value );
+    void addBranch( unsigned iCat, const std::string & name, Int_t * bin );
+    void bookColumns( unsigned iCat );
+
     // Fill n-tuples
     void fill();
     void fill( unsigned iCat, const edm::Handle< TtSemiLeptonicEvent > & ttSemiLeptonicEvent, bool repeat = false );
+    void fillCategory( unsigned iCat );
+    void flushColumns();
 
 };
 
 
 #include <cassert>
+#include <cctype>
 #include <iostream>
 #include <sstream>
 
@@ -220,7 +244,9 @@ AnalyzeHitFit::AnalyzeHitFit( const edm::ParameterSet & iConfig )
 , jecLevel_( iConfig.getParameter< std::string >( "jecLevel" ) )
 , pathPlots_( iConfig.getParameter< std::string >( "pathPlots" ) )
 , plot_( ! pathPlots_.empty() )
+, columnBatchSize_( iConfig.existsAs< unsigned >( "columnBatchSize" ) ? iConfig.getParameter< unsigned >( "columnBatchSize" ) : 0 )
 , filledEvents_( 0 )
+, batchEvents_( 0 )
 {
 
   lumiWeightTrue_     = edm::LumiReWeighting( pileUpFileMCTrue_.fullPath()    , pileUpFileDataTrue_.fullPath()    , "pileup", "pileup" );
@@ -352,6 +378,14 @@ void AnalyzeHitFit::beginJob()
     histo_pileUpWeightObserved_->Fill( iBin, lumiWeightObserved_.weight( iBin ) );
   }
 
+  // The column buffers must not move, once the trees hold their addresses
+  catValueNames_.resize( objCats_.size() );
+  catValues_.resize( objCats_.size() );
+  catBinNames_.resize( objCats_.size() );
+  catBins_.resize( objCats_.size() );
+  catValueColumns_.resize( objCats_.size() );
+  catBinColumns_.resize( objCats_.size() );
+
   for ( unsigned iCat = 0; iCat < objCats_.size(); ++iCat ) {
     const std::string cat( objCats_.at( iCat ) );
     TFileDirectory dir( fileService->mkdir( cat.c_str(), "" ) );
@@ -375,34 +409,38 @@ void AnalyzeHitFit::beginJob()
     }
 
     // N-tuple
-    catData_.push_back( dir.make< TTree >( std::string( cat + "_data" ).c_str(), std::string( cat + " data" ).c_str() ) );
-    catData_.back()->Branch( "Pt"        , &pt_        , "pt/D" );
-    catData_.back()->Branch( "Eta"       , &eta_       , "eta/D" );
-    catData_.back()->Branch( "Phi"       , &phi_       , "phi/D" );
-    catData_.back()->Branch( "BinEta"    , &binEta_    , "binEta/I" );
-    catData_.back()->Branch( "BinEtaSymm", &binEtaSymm_, "binEtaSymm/I" );
-    catData_.back()->Branch( "PtAlt"        , &ptAlt_        , "ptAlt/D" );
-    catData_.back()->Branch( "EtaAlt"       , &etaAlt_       , "etaAlt/D" );
-    catData_.back()->Branch( "PhiAlt"       , &phiAlt_       , "phiAlt/D" );
-    catData_.back()->Branch( "BinEtaAlt"    , &binEtaAlt_    , "binEtaAlt/I" );
-    catData_.back()->Branch( "BinEtaSymmAlt", &binEtaSymmAlt_, "binEtaSymmAlt/I" );
+    if ( columnBatchSize_ > 0 )
+      catData_.push_back( dir.make< TTree >( std::string( cat + "_columns" ).c_str(), std::string( cat + " data, " + boost::lexical_cast< std::string >( columnBatchSize_ ) + " events per entry" ).c_str() ) );
+    else
+      catData_.push_back( dir.make< TTree >( std::string( cat + "_data" ).c_str(), std::string( cat + " data" ).c_str() ) );
+    addBranch( iCat, "Pt"        , &pt_ );
+    addBranch( iCat, "Eta"       , &eta_ );
+    addBranch( iCat, "Phi"       , &phi_ );
+    addBranch( iCat, "BinEta"    , &binEta_ );
+    addBranch( iCat, "BinEtaSymm", &binEtaSymm_ );
+    addBranch( iCat, "PtAlt"        , &ptAlt_ );
+    addBranch( iCat, "EtaAlt"       , &etaAlt_ );
+    addBranch( iCat, "PhiAlt"       , &phiAlt_ );
+    addBranch( iCat, "BinEtaAlt"    , &binEtaAlt_ );
+    addBranch( iCat, "BinEtaSymmAlt", &binEtaSymmAlt_ );
     if ( cat == "UdscJet" || cat == "BJet" ) {
-      catData_.back()->Branch( "PtGenJet"        , &ptGenJet_        , "ptGenJet/D" );
-      catData_.back()->Branch( "EtaGenJet"       , &etaGenJet_       , "etaGenJet/D" );
-      catData_.back()->Branch( "PhiGenJet"       , &phiGenJet_       , "phiGenJet/D" );
-      catData_.back()->Branch( "BinEtaGenJet"    , &binEtaGenJet_    , "binEtaGenJet/I" );
-      catData_.back()->Branch( "BinEtaSymmGenJet", &binEtaSymmGenJet_, "binEtaSymmGenJet/I" );
-      catData_.back()->Branch( "PtGenJetAlt"        , &ptGenJetAlt_        , "ptGenJetAlt/D" );
-      catData_.back()->Branch( "EtaGenJetAlt"       , &etaGenJetAlt_       , "etaGenJetAlt/D" );
-      catData_.back()->Branch( "PhiGenJetAlt"       , &phiGenJetAlt_       , "phiGenJetAlt/D" );
-      catData_.back()->Branch( "BinEtaGenJetAlt"    , &binEtaGenJetAlt_    , "binEtaGenJetAlt/I" );
-      catData_.back()->Branch( "BinEtaSymmGenJetAlt", &binEtaSymmGenJetAlt_, "binEtaSymmGenJetAlt/I" );
+      addBranch( iCat, "PtGenJet"        , &ptGenJet_ );
+      addBranch( iCat, "EtaGenJet"       , &etaGenJet_ );
+      addBranch( iCat, "PhiGenJet"       , &phiGenJet_ );
+      addBranch( iCat, "BinEtaGenJet"    , &binEtaGenJet_ );
+      addBranch( iCat, "BinEtaSymmGenJet", &binEtaSymmGenJet_ );
+      addBranch( iCat, "PtGenJetAlt"        , &ptGenJetAlt_ );
+      addBranch( iCat, "EtaGenJetAlt"       , &etaGenJetAlt_ );
+      addBranch( iCat, "PhiGenJetAlt"       , &phiGenJetAlt_ );
+      addBranch( iCat, "BinEtaGenJetAlt"    , &binEtaGenJetAlt_ );
+      addBranch( iCat, "BinEtaSymmGenJetAlt", &binEtaSymmGenJetAlt_ );
     }
-    catData_.back()->Branch( "PtGen"        , &ptGen_        , "ptGen/D" );
-    catData_.back()->Branch( "EtaGen"       , &etaGen_       , "etaGen/D" );
-    catData_.back()->Branch( "PhiGen"       , &phiGen_       , "phiGen/D" );
-    catData_.back()->Branch( "BinEtaGen"    , &binEtaGen_    , "binEtaGen/I" );
-    catData_.back()->Branch( "BinEtaSymmGen", &binEtaSymmGen_, "binEtaSymmGen/I" );
+    addBranch( iCat, "PtGen"        , &ptGen_ );
+    addBranch( iCat, "EtaGen"       , &etaGen_ );
+    addBranch( iCat, "PhiGen"       , &phiGen_ );
+    addBranch( iCat, "BinEtaGen"    , &binEtaGen_ );
+    addBranch( iCat, "BinEtaSymmGen", &binEtaSymmGen_ );
+    bookColumns( iCat );
 
     for ( unsigned iProp = 0; iProp < kinProps_.size(); ++iProp ) {
       const std::string prop( kinProps_.at( iProp ) );
@@ -566,7 +604,7 @@ void AnalyzeHitFit::analyze( const edm::Event & iEvent, const edm::EventSetup &
             else edm::LogInfo( "AnalyzeHitFit" ) << "...no valid MC match in both channel";
           }
           // Fill tree
-          catData_.at( iCat )->Fill();
+          fillCategory( iCat );
 
           // Do it again for jets
           if ( cat == "UdscJet" || cat == "BJet" ) {
@@ -603,12 +641,13 @@ void AnalyzeHitFit::analyze( const edm::Event & iEvent, const edm::EventSetup &
               fill( iCat, ttSemiLeptonicEventElecs_, true );
             }
             else edm::LogInfo( "AnalyzeHitFit" ) << "...no valid MC match in both channel";
-            catData_.at( iCat )->Fill();
+            fillCategory( iCat );
           }
         }
         fill();
         data_->Fill();
         ++filledEvents_;
+        if ( columnBatchSize_ > 0 && ++batchEvents_ == columnBatchSize_ ) flushColumns();
 
       } // Valid full TTbar MC matching
       else edm::LogInfo( "AnalyzeHitFit" ) << "...no valid MC match";
@@ -625,6 +664,9 @@ void AnalyzeHitFit::analyze( const edm::Event & iEvent, const edm::EventSetup &
 void AnalyzeHitFit::endJob()
 {
 
+  // Write the last, incomplete batch
+  if ( columnBatchSize_ > 0 && batchEvents_ > 0 ) flushColumns();
+
   edm::LogPrint( "AnalyzeHitFit" ) << "\n\n**************\nFilled events: " << filledEvents_ << "\n**************\n";
 
   if ( plot_ ) {
@@ -715,6 +757,40 @@ void AnalyzeHitFit::endJob()
 }
 
 
+void AnalyzeHitFit::fillCategory( unsigned iCat )
+{
+
+  if ( columnBatchSize_ == 0 ) {
+    catData_.at( iCat )->Fill();
+    return;
+  }
+  for ( unsigned iValue = 0; iValue < catValues_.at( iCat ).size(); ++iValue ) {
+    catValueColumns_.at( iCat ).at( iValue ).push_back( *( catValues_.at( iCat ).at( iValue ) ) );
+  }
+  for ( unsigned iBin = 0; iBin < catBins_.at( iCat ).size(); ++iBin ) {
+    catBinColumns_.at( iCat ).at( iBin ).push_back( *( catBins_.at( iCat ).at( iBin ) ) );
+  }
+
+}
+
+
+void AnalyzeHitFit::flushColumns()
+{
+
+  for ( unsigned iCat = 0; iCat < objCats_.size(); ++iCat ) {
+    catData_.at( iCat )->Fill();
+    for ( unsigned iValue = 0; iValue < catValueColumns_.at( iCat ).size(); ++iValue ) {
+      catValueColumns_.at( iCat ).at( iValue ).clear();
+    }
+    for ( unsigned iBin = 0; iBin < catBinColumns_.at( iCat ).size(); ++iBin ) {
+      catBinColumns_.at( iCat ).at( iBin ).clear();
+    }
+  }
+  batchEvents_ = 0;
+
+}
+
+
 unsigned AnalyzeHitFit::getEtaBin( unsigned iCat, double eta, bool symm )
 {
 
@@ -729,6 +805,62 @@ unsigned AnalyzeHitFit::getEtaBin( unsigned iCat, double eta, bool symm )
 }
 
 
+void AnalyzeHitFit::addBranch( unsigned iCat, const std::string & name, Double_t * value )
+{
+
+  if ( columnBatchSize_ > 0 ) {
+    catValueNames_.at( iCat ).push_back( name );
+    catValues_.at( iCat ).push_back( value );
+  }
+  else {
+    std::string leaf( name );
+    leaf.at( 0 ) = std::tolower( leaf.at( 0 ) );
+    catData_.at( iCat )->Branch( name.c_str(), value, std::string( leaf + "/D" ).c_str() );
+  }
+
+}
+
+
+void AnalyzeHitFit::addBranch( unsigned iCat, const std::string & name, Int_t * bin )
+{
+
+  if ( columnBatchSize_ > 0 ) {
+    catBinNames_.at( iCat ).push_back( name );
+    catBins_.at( iCat ).push_back( bin );
+  }
+  else {
+    std::string leaf( name );
+    leaf.at( 0 ) = std::tolower( leaf.at( 0 ) );
+    catData_.at( iCat )->Branch( name.c_str(), bin, std::string( leaf + "/I" ).c_str() );
+  }
+
+}
+
+
+// The buffers of a category have to be complete before its branches are
+// created, since the tree keeps their addresses.
+void AnalyzeHitFit::bookColumns( unsigned iCat )
+{
+
+  if ( columnBatchSize_ == 0 ) return;
+
+  // Jet categories are filled twice per event
+  const std::string cat( objCats_.at( iCat ) );
+  const unsigned nObjects( ( cat == "UdscJet" || cat == "BJet" ) ? 2 * columnBatchSize_ : columnBatchSize_ );
+  catValueColumns_.at( iCat ).resize( catValues_.at( iCat ).size() );
+  catBinColumns_.at( iCat ).resize( catBins_.at( iCat ).size() );
+  for ( unsigned iValue = 0; iValue < catValueColumns_.at( iCat ).size(); ++iValue ) {
+    catValueColumns_.at( iCat ).at( iValue ).reserve( nObjects );
+    catData_.at( iCat )->Branch( catValueNames_.at( iCat ).at( iValue ).c_str(), &( catValueColumns_.at( iCat ).at( iValue ) ) );
+  }
+  for ( unsigned iBin = 0; iBin < catBinColumns_.at( iCat ).size(); ++iBin ) {
+    catBinColumns_.at( iCat ).at( iBin ).reserve( nObjects );
+    catData_.at( iCat )->Branch( catBinNames_.at( iCat ).at( iBin ).c_str(), &( catBinColumns_.at( iCat ).at( iBin ) ) );
+  }
+
+}
+
+
 void AnalyzeHitFit::fill()
 {
 
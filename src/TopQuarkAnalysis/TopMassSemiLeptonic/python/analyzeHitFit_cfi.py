@@ -40,6 +40,10 @@ analyzeHitFit = cms.EDAnalyzer(
 
 , pathPlots = cms.string( '' ) # empty string prevents from plotting
 
+  # Columnar n-tuples: number of events per entry of the '<category>_columns' trees,
+  # which replace the '<category>_data' trees (0: one entry per object)
+, columnBatchSize = cms.uint32( 0 )
+
   # Eta binning (overrides input from resolution files, if not empty)
 , muonEtaBins     = cms.vdouble()
 , electronEtaBins = cms.vdouble()
@@ -0,0 +1,98 @@
+//
+// $Id:$
+//
+
+
+#include "TopQuarkAnalysis/TopMassSemiLeptonic/interface/InputFileIndex.h"
+
+#include "boost/lexical_cast.hpp"
+
+#include <vector>
+
+#include <TKey.h>
+
+
+using namespace my;
+
+
+namespace {
+
+  /// Records the keys of 'dir' and, if 'recursive', of all its sub-directories
+  void indexDirectory( TDirectory * dir, bool recursive, std::map< const TDirectory *, InputFileIndex::KeyIndex > & keyIndices, std::map< const TDirectory *, std::map< std::string, TObject * > > & directories )
+  {
+    InputFileIndex::KeyIndex & keys( keyIndices[ dir ] );
+    std::vector< std::string > subDirs;
+    TIter nextKey( dir->GetListOfKeys() );
+    while ( TKey * key = ( TKey* )nextKey() ) {
+      const std::string name( key->GetName() );
+      const std::string className( key->GetClassName() );
+      keys[ name + ";" + boost::lexical_cast< std::string >( key->GetCycle() ) ] = className;
+      if ( keys.insert( std::make_pair( name, className ) ).second && recursive && ( className == "TDirectoryFile" || className == "TDirectory" ) ) {
+        subDirs.push_back( name );
+      }
+    }
+    for ( unsigned iDir = 0; iDir < subDirs.size(); ++iDir ) {
+      TDirectory * subDir( dir->GetDirectory( subDirs.at( iDir ).c_str() ) );
+      if ( ! subDir ) continue;
+      directories[ dir ][ subDirs.at( iDir ) ] = subDir;
+      indexDirectory( subDir, true, keyIndices, directories );
+    }
+  }
+
+}
+
+
+// Constructors and Destructor
+
+// Constructor from a file name
+InputFileIndex::InputFileIndex( const std::string & fileName, const std::string & option, const std::string & top )
+: file_( TFile::Open( fileName.c_str(), option.c_str() ) )
+, keys_()
+, objects_()
+{
+  if ( ! file_ ) return;
+  if ( file_->IsZombie() ) {
+    delete file_;
+    file_ = 0;
+    return;
+  }
+  indexDirectory( file_, top.empty(), keys_, objects_ );
+  if ( top.empty() ) return;
+  TDirectory * dirTop( file_->GetDirectory( top.c_str() ) );
+  if ( ! dirTop ) return;
+  if ( top.find( '/' ) == std::string::npos ) objects_[ file_ ][ top ] = dirTop;
+  indexDirectory( dirTop, true, keys_, objects_ );
+}
+
+
+// Methods
+
+TObject * InputFileIndex::Get( TDirectory * dir, const std::string & name )
+{
+  if ( ! dir ) return 0;
+  std::map< const TDirectory *, KeyIndex >::const_iterator iKeys( keys_.find( dir ) );
+  if ( iKeys == keys_.end() ) return dir->Get( name.c_str() );
+
+  // As in TDirectory::Get(), objects in memory (e.g. created after the indexing) take precedence
+  if ( name.find( ';' ) == std::string::npos && dir->GetList() ) {
+    if ( TObject * object = dir->GetList()->FindObject( name.c_str() ) ) return object;
+  }
+  std::map< std::string, TObject * > & objects( objects_[ dir ] );
+  std::map< std::string, TObject * >::const_iterator iObject( objects.find( name ) );
+  if ( iObject != objects.end() ) return iObject->second;
+  if ( iKeys->second.find( name ) == iKeys->second.end() ) return 0;
+  TObject * object( dir->Get( name.c_str() ) );
+  objects[ name ] = object;
+  return object;
+}
+
+
+void InputFileIndex::Delete( TDirectory * dir, const std::string & name )
+{
+  std::map< const TDirectory *, std::map< std::string, TObject * > >::iterator iObjects( objects_.find( dir ) );
+  if ( iObjects == objects_.end() ) return;
+  std::map< std::string, TObject * >::iterator iObject( iObjects->second.find( name ) );
+  if ( iObject == iObjects->second.end() ) return;
+  delete iObject->second;
+  iObjects->second.erase( iObject );
+}
@@ -0,0 +1,182 @@
+//
+// $Id:$
+//
+
+
+#include "TopQuarkAnalysis/TopMassSemiLeptonic/interface/TransferFunctionClosure.h"
+
+#include <cmath>
+
+#include <TRandom3.h>
+
+#include "tbb/task_scheduler_init.h"
+#include "tbb/parallel_for.h"
+#include "tbb/blocked_range.h"
+
+
+using namespace my;
+
+
+namespace {
+
+  /// Maximum number of acceptance-rejection rounds per block
+  const unsigned maxRounds( 1000 );
+
+  /// Computes the pulls of a range of blocks
+  class ClosureBody {
+
+      const TransferFunctionClosure & closure_;
+      unsigned n_;
+      const double * refValues_;
+      const double * nonRefValues_;
+      double * pulls_;
+      unsigned stream_;
+
+    public:
+
+      ClosureBody( const TransferFunctionClosure & closure, unsigned n, const double * refValues, const double * nonRefValues, double * pulls, unsigned stream )
+      : closure_( closure )
+      , n_( n )
+      , refValues_( refValues )
+      , nonRefValues_( nonRefValues )
+      , pulls_( pulls )
+      , stream_( stream )
+      {}
+
+      void operator()( const tbb::blocked_range< size_t > & blocks ) const
+      {
+        for ( size_t block = blocks.begin(); block != blocks.end(); ++block ) {
+          const unsigned first( block * TransferFunctionClosure::blockSize );
+          const unsigned size( std::min( TransferFunctionClosure::blockSize, n_ - first ) );
+          closure_.PullsBlock( size, refValues_ + first, nonRefValues_ + first, pulls_ + first, stream_, block );
+        }
+      }
+
+  };
+
+}
+
+
+const unsigned TransferFunctionClosure::blockSize;
+
+
+// Constructors and Destructor
+
+// Constructor from TransferFunctionTable
+TransferFunctionClosure::TransferFunctionClosure( const TransferFunctionTable & table, unsigned seed )
+: table_( table )
+, moment0_( table.NNodesDependency(), 0. )
+, moment1_( table.NNodesDependency(), 0. )
+, moment2_( table.NNodesDependency(), 0. )
+, maximum_( table.NNodesDependency(), 0. )
+, seed_( seed )
+{
+  if ( table_.Empty() ) return;
+  // Exact integrals of the function, linear between the nodes
+  const double step( ( table_.ValueMax() - table_.ValueMin() ) / ( table_.NNodesValue() - 1 ) );
+  for ( unsigned iDependency = 0; iDependency < table_.NNodesDependency(); ++iDependency ) {
+    for ( unsigned iValue = 0; iValue < table_.NNodesValue(); ++iValue ) {
+      maximum_[ iDependency ] = std::max( maximum_[ iDependency ], table_.Node( iDependency, iValue ) );
+      if ( iValue == 0 ) continue;
+      const double a( table_.ValueMin() + ( iValue - 1 ) * step );
+      const double b( a + step );
+      const double fa( table_.Node( iDependency, iValue - 1 ) );
+      const double fb( table_.Node( iDependency, iValue ) );
+      moment0_[ iDependency ] += step * ( fa + fb ) / 2.;
+      moment1_[ iDependency ] += step * ( fa * ( 2. * a + b ) + fb * ( a + 2. * b ) ) / 6.;
+      moment2_[ iDependency ] += step * ( fa * ( 3. * a * a + 2. * a * b + b * b ) + fb * ( a * a + 2. * a * b + 3. * b * b ) ) / 12.;
+    }
+  }
+}
+
+
+// Methods
+
+void TransferFunctionClosure::Position( double dependencyValue, unsigned & node, double & fraction ) const
+{
+  const unsigned nDependency( table_.NNodesDependency() );
+  const double step( ( table_.DependencyMax() - table_.DependencyMin() ) / ( nDependency - 1 ) );
+  double t( step > 0. ? ( dependencyValue - table_.DependencyMin() ) / step : 0. );
+  if ( ! ( t > 0. ) ) t = 0.;
+  if ( t > ( double )( nDependency - 1 ) ) t = ( double )( nDependency - 1 );
+  node     = std::min( ( unsigned )t, nDependency - 2 );
+  fraction = t - node;
+}
+
+
+// Evaluate
+
+double TransferFunctionClosure::Sigma( double dependencyValue ) const
+{
+  if ( table_.Empty() ) return 0.;
+  unsigned node;
+  double fraction;
+  Position( dependencyValue, node, fraction );
+  // The moments are linear in the interpolated function
+  const double m0( ( 1. - fraction ) * moment0_[ node ] + fraction * moment0_[ node + 1 ] );
+  if ( ! ( m0 > 0. ) ) return 0.;
+  const double mean( ( ( 1. - fraction ) * moment1_[ node ] + fraction * moment1_[ node + 1 ] ) / m0 );
+  const double variance( ( ( 1. - fraction ) * moment2_[ node ] + fraction * moment2_[ node + 1 ] ) / m0 - mean * mean );
+  return variance > 0. ? std::sqrt( variance ) : 0.;
+}
+
+
+void TransferFunctionClosure::Pulls( unsigned n, const double * refValues, const double * nonRefValues, double * pulls, unsigned stream, unsigned nThreads ) const
+{
+  const unsigned nBlocks( ( n + blockSize - 1 ) / blockSize );
+  ClosureBody body( *this, n, refValues, nonRefValues, pulls, stream );
+  if ( nThreads == 1 || nBlocks < 2 ) {
+    body( tbb::blocked_range< size_t >( 0, nBlocks ) );
+  }
+  else {
+    tbb::task_scheduler_init init( nThreads == 0 ? int( tbb::task_scheduler_init::automatic ) : int( nThreads ) );
+    tbb::parallel_for( tbb::blocked_range< size_t >( 0, nBlocks, 1 ), body );
+  }
+}
+
+
+void TransferFunctionClosure::PullsBlock( unsigned n, const double * refValues, const double * nonRefValues, double * pulls, unsigned stream, unsigned block ) const
+{
+  std::fill( pulls, pulls + n, transferFunctionClosureInvalid );
+  if ( table_.Empty() ) return;
+
+  // Envelope for the acceptance-rejection: the bilinear interpolation does not exceed the neighbouring nodes
+  std::vector< unsigned > pending;
+  std::vector< double > envelope( n, 0. );
+  std::vector< double > sigma( n, 0. );
+  for ( unsigned k = 0; k < n; ++k ) {
+    sigma[ k ] = Sigma( refValues[ k ] );
+    if ( ! ( sigma[ k ] > 0. ) ) continue;
+    unsigned node;
+    double fraction;
+    Position( refValues[ k ], node, fraction );
+    envelope[ k ] = fraction > 0. ? std::max( maximum_[ node ], maximum_[ node + 1 ] ) : maximum_[ node ];
+    if ( envelope[ k ] > 0. ) pending.push_back( k );
+  }
+
+  // One random number stream per block; 0 would be replaced by a time dependent seed
+  TRandom3 random( seed_ + 1000003u * stream + block + 1 );
+  const double valueMin( table_.ValueMin() );
+  const double valueRange( table_.ValueMax() - table_.ValueMin() );
+  std::vector< double > dependencyValues( pending.size() );
+  std::vector< double > candidates( pending.size() );
+  std::vector< double > heights( pending.size() );
+  std::vector< double > values( pending.size() );
+  std::vector< unsigned > rejected;
+  for ( unsigned round = 0; round < maxRounds && ! pending.empty(); ++round ) {
+    const unsigned m( pending.size() );
+    for ( unsigned j = 0; j < m; ++j ) {
+      dependencyValues[ j ] = refValues[ pending[ j ] ];
+      candidates[ j ]       = valueMin + random.Rndm() * valueRange;
+      heights[ j ]          = random.Rndm() * envelope[ pending[ j ] ];
+    }
+    table_.Eval( m, &dependencyValues.front(), &candidates.front(), &values.front() );
+    rejected.clear();
+    for ( unsigned j = 0; j < m; ++j ) {
+      const unsigned k( pending[ j ] );
+      if ( heights[ j ] < values[ j ] ) pulls[ k ] = ( refValues[ k ] - nonRefValues[ k ] - candidates[ j ] ) / sigma[ k ];
+      else                              rejected.push_back( k );
+    }
+    pending.swap( rejected );
+  }
+}
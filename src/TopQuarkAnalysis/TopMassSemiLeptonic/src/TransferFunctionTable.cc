@@ -0,0 +1,192 @@
+//
+// $Id:$
+//
+
+
+#include "TopQuarkAnalysis/TopMassSemiLeptonic/interface/TransferFunctionTable.h"
+
+#include <cmath>
+#include <iomanip>
+
+#include <TF1.h>
+
+
+using namespace my;
+
+
+namespace {
+
+  /// Fit function with its parameters set for a given value of the dependency variable,
+  /// as used in TransferFunction::Eval( dependencyValue, value, norm )
+  TF1 fitFunctionAt( const TransferFunction & transfer, double dependencyValue, int norm )
+  {
+    TF1 fitFunc;
+    if ( transfer.FitFunction().empty() && ! transfer.FitFunctionString().empty() ) {
+      fitFunc = TF1( "fitFunc", transfer.FitFunctionString().c_str() );
+    }
+    else {
+      fitFunc = TF1( transfer.GetFitFunction() );
+    }
+    TF1 depFunc( transfer.GetDependencyFunction() );
+    for ( unsigned i = 0; i < transfer.NParFit(); ++i ) {
+      if ( ( int )i == norm ) {
+        fitFunc.SetParameter( ( Int_t )i, 1. );
+        continue;
+      }
+      for ( unsigned j = 0; j < transfer.NParDependency(); ++j ) {
+        depFunc.SetParameter( ( Int_t )j, ( Double_t )( transfer.Parameter( i, j ) ) );
+      }
+      fitFunc.SetParameter( ( Int_t )i, ( Double_t )( depFunc.Eval( dependencyValue ) ) );
+    }
+    return fitFunc;
+  }
+
+}
+
+
+// Constructors and Destructor
+
+// Default constructor (empty table)
+TransferFunctionTable::TransferFunctionTable()
+: dependencyMin_( 0. )
+, dependencyStep_( 0. )
+, dependencyScale_( 0. )
+, nDependency_( 0 )
+, valueMin_( 0. )
+, valueStep_( 0. )
+, valueScale_( 0. )
+, nValue_( 0 )
+, table_()
+, maxError_( 0. )
+{
+}
+
+// Constructor from TransferFunction
+TransferFunctionTable::TransferFunctionTable( const TransferFunction & transfer, double dependencyMin, double dependencyMax, double valueMin, double valueMax, double tolerance, int norm, unsigned maxNodes )
+: table_()
+, maxError_( 0. )
+{
+  unsigned nDependency( 3 );
+  unsigned nValue( 3 );
+  while ( true ) {
+    SetAxes( dependencyMin, dependencyMax, nDependency, valueMin, valueMax, nValue );
+
+    // Fill the nodes
+    table_.resize( nDependency_ * nValue_ );
+    for ( unsigned iDependency = 0; iDependency < nDependency_; ++iDependency ) {
+      const TF1 fitFunc( fitFunctionAt( transfer, dependencyMin_ + iDependency * dependencyStep_, norm ) );
+      for ( unsigned iValue = 0; iValue < nValue_; ++iValue ) {
+        table_[ iDependency * nValue_ + iValue ] = fitFunc.Eval( valueMin_ + iValue * valueStep_ );
+      }
+    }
+
+    // Compare to the analytic function at the midpoints of the cell edges along the dependency
+    // axis, along the fit variable axis and at the cell centres
+    double errorDependency( 0. );
+    double errorValue( 0. );
+    double errorCentre( 0. );
+    for ( unsigned iDependency = 0; iDependency < 2 * nDependency_ - 1; ++iDependency ) {
+      const double dependencyValue( dependencyMin_ + 0.5 * iDependency * dependencyStep_ );
+      const TF1 fitFunc( fitFunctionAt( transfer, dependencyValue, norm ) );
+      for ( unsigned iValue = iDependency % 2 == 0 ? 1 : 0; iValue < 2 * nValue_ - 1; iValue += iDependency % 2 == 0 ? 2 : 1 ) {
+        const double value( valueMin_ + 0.5 * iValue * valueStep_ );
+        const double error( std::fabs( fitFunc.Eval( value ) - Eval( dependencyValue, value ) ) );
+        if      ( iDependency % 2 == 0 ) errorValue      = std::max( errorValue, error );
+        else if ( iValue % 2 == 0 )      errorDependency = std::max( errorDependency, error );
+        else                             errorCentre     = std::max( errorCentre, error );
+      }
+    }
+    maxError_ = std::max( errorCentre, std::max( errorDependency, errorValue ) );
+    if ( maxError_ <= tolerance ) break;
+
+    // Refine along the axis with the larger error, along both for dominating errors at the cell centres
+    const bool refineDependency( errorDependency >= errorValue  || errorCentre > std::max( errorDependency, errorValue ) );
+    const bool refineValue(      errorValue >= errorDependency  || errorCentre > std::max( errorDependency, errorValue ) );
+    const unsigned nDependencyNew( refineDependency ? 2 * nDependency_ - 1 : nDependency_ );
+    const unsigned nValueNew( refineValue ? 2 * nValue_ - 1 : nValue_ );
+    if ( nDependencyNew * nValueNew > maxNodes ) break;
+    nDependency = nDependencyNew;
+    nValue      = nValueNew;
+  }
+}
+
+
+// Methods
+
+// Sets the axes
+void TransferFunctionTable::SetAxes( double dependencyMin, double dependencyMax, unsigned nDependency, double valueMin, double valueMax, unsigned nValue )
+{
+  dependencyMin_   = dependencyMin;
+  nDependency_     = nDependency;
+  dependencyStep_  = ( dependencyMax - dependencyMin ) / ( nDependency - 1 );
+  dependencyScale_ = dependencyStep_ > 0. ? 1. / dependencyStep_ : 0.;
+  valueMin_        = valueMin;
+  nValue_          = nValue;
+  valueStep_       = ( valueMax - valueMin ) / ( nValue - 1 );
+  valueScale_      = valueStep_ > 0. ? 1. / valueStep_ : 0.;
+}
+
+
+// Evaluate
+
+// The loop body has no branches depending on the points, so that it can be vectorised.
+void TransferFunctionTable::Eval( unsigned n, const double * dependencyValues, const double * values, double * results ) const
+{
+  if ( table_.empty() ) {
+    std::fill( results, results + n, 0. );
+    return;
+  }
+  const double tMax( ( double )( nDependency_ - 1 ) );
+  const double uMax( ( double )( nValue_ - 1 ) );
+  const double * table( &table_.front() );
+  for ( unsigned k = 0; k < n; ++k ) {
+    double u( ( values[ k ] - valueMin_ ) * valueScale_ );
+    const double inside( ( u >= 0. && u <= uMax ) ? 1. : 0. );
+    u = std::min( std::max( u, 0. ), uMax );
+    const double t( std::min( std::max( ( dependencyValues[ k ] - dependencyMin_ ) * dependencyScale_, 0. ), tMax ) );
+    const unsigned iDependency( std::min( ( unsigned )t, nDependency_ - 2 ) );
+    const unsigned iValue( std::min( ( unsigned )u, nValue_ - 2 ) );
+    const double ft( t - iDependency );
+    const double fu( u - iValue );
+    const double * low( table + iDependency * nValue_ + iValue );
+    const double * high( low + nValue_ );
+    results[ k ] = inside * ( ( 1. - ft ) * ( ( 1. - fu ) * low[ 0 ] + fu * low[ 1 ] ) + ft * ( ( 1. - fu ) * high[ 0 ] + fu * high[ 1 ] ) );
+  }
+}
+
+
+// Communication
+
+void TransferFunctionTable::Write( std::ostream & stream ) const
+{
+  const std::streamsize precision( stream.precision( 17 ) );
+  stream << "TransferFunctionTable" << std::endl
+         << nDependency_ << " " << DependencyMin() << " " << DependencyMax() << std::endl
+         << nValue_      << " " << ValueMin()      << " " << ValueMax()      << std::endl
+         << maxError_ << std::endl;
+  for ( unsigned iDependency = 0; iDependency < nDependency_; ++iDependency ) {
+    for ( unsigned iValue = 0; iValue < nValue_; ++iValue ) {
+      if ( iValue > 0 ) stream << " ";
+      stream << table_[ iDependency * nValue_ + iValue ];
+    }
+    stream << std::endl;
+  }
+  stream.precision( precision );
+}
+
+TransferFunctionTable TransferFunctionTable::Read( std::istream & stream )
+{
+  TransferFunctionTable table;
+  std::string header;
+  unsigned nDependency, nValue;
+  double dependencyMin, dependencyMax, valueMin, valueMax, maxError;
+  stream >> header >> nDependency >> dependencyMin >> dependencyMax >> nValue >> valueMin >> valueMax >> maxError;
+  if ( ! stream || header != "TransferFunctionTable" || nDependency < 2 || nValue < 2 ) return TransferFunctionTable();
+  std::vector< double > values( nDependency * nValue );
+  for ( unsigned i = 0; i < values.size(); ++i ) stream >> values[ i ];
+  if ( ! stream ) return TransferFunctionTable();
+  table.SetAxes( dependencyMin, dependencyMax, nDependency, valueMin, valueMax, nValue );
+  table.table_.swap( values );
+  table.maxError_ = maxError;
+  return table;
+}
@@ -0,0 +1,643 @@
+//
+// $Id:$
+//
+
+
+#include "TopQuarkAnalysis/TopMassSemiLeptonic/interface/UnbinnedFit.h"
+
+#include <memory>
+#include <algorithm>
+#include "boost/lexical_cast.hpp"
+
+#include "TMath.h"
+#include "TError.h"
+#include "Math/IFunction.h"
+#include "Minuit2/Minuit2Minimizer.h"
+
+#include "tbb/task_scheduler_init.h"
+#include "tbb/parallel_for.h"
+#include "tbb/blocked_range.h"
+
+
+using namespace my;
+
+
+namespace {
+
+  /// Value returned for parameters, for which the function is not a valid p.d.f.
+  const double invalidNLL( 1.e30 );
+
+  /// Suppresses ROOT info messages for the lifetime of the object
+  /// Minuit2Minimizer::Minimize() with print level 0 raises 'gErrorIgnoreLevel' to
+  /// suppress info messages and restores it afterwards. Concurrent fits would race on
+  /// this global. Minuit2 leaves it untouched, if it is raised already, so it is raised
+  /// once before and restored after the parallel section.
+  class SuppressInfoMessages {
+
+      Int_t previous_;
+
+    public:
+
+      SuppressInfoMessages()
+      : previous_( gErrorIgnoreLevel )
+      {
+        if ( gErrorIgnoreLevel < kInfo + 1 ) gErrorIgnoreLevel = kInfo + 1;
+      }
+
+      ~SuppressInfoMessages() { gErrorIgnoreLevel = previous_; }
+
+  };
+
+  /// Negative log-likelihood of a sample for the shape of a my::Function
+  /// The weights are scaled by sum( w ) / sum( w^2 ), so that the parameter errors
+  /// correspond to the effective number of entries.
+  /// The shape is normalised over the fit range with Simpson's rule.
+  class UnbinnedLikelihood : public ROOT::Math::IMultiGradFunction {
+
+      Function * function_;
+      const UnbinnedSample * sample_;
+      unsigned nPar_;
+      Double_t sumWeights_;
+      std::vector< Double_t > weights_;
+      std::vector< Double_t > nodes_;
+      std::vector< Double_t > nodeWeights_;
+      /// Buffers
+      mutable std::vector< Double_t > par_;
+      mutable std::vector< Double_t > values_;
+      mutable std::vector< Double_t > nodeValues_;
+      mutable std::vector< Double_t > grad_;
+
+    public:
+
+      UnbinnedLikelihood( Function * function, const UnbinnedSample & sample, UInt_t nIntegration )
+      : function_( function )
+      , sample_( &sample )
+      , nPar_( function->NParameters() )
+      , sumWeights_( 0. )
+      , par_( nPar_ )
+      , values_( sample.values.size() )
+      , nodeValues_( 2 * ( ( nIntegration + 1 ) / 2 ) + 1 )
+      , grad_( nPar_ )
+      {
+        Double_t sumWeights2( 0. );
+        for ( size_t i = 0; i < sample.weights.size(); ++i ) {
+          sumWeights_ += sample.weights[ i ];
+          sumWeights2 += sample.weights[ i ] * sample.weights[ i ];
+        }
+        const Double_t scale( sumWeights2 > 0. ? sumWeights_ / sumWeights2 : 1. );
+        weights_.reserve( sample.weights.size() );
+        for ( size_t i = 0; i < sample.weights.size(); ++i ) weights_.push_back( scale * sample.weights[ i ] );
+        sumWeights_ *= scale;
+        const size_t nNodes( nodeValues_.size() );
+        const Double_t step( ( sample.max - sample.min ) / ( nNodes - 1 ) );
+        nodes_.reserve( nNodes );
+        nodeWeights_.reserve( nNodes );
+        for ( size_t k = 0; k < nNodes; ++k ) {
+          nodes_.push_back( sample.min + k * step );
+          nodeWeights_.push_back( ( k == 0 || k == nNodes - 1 ) ? step / 3. : ( k % 2 == 1 ? 4. * step / 3. : 2. * step / 3. ) );
+        }
+      }
+
+      virtual ROOT::Math::IMultiGenFunction * Clone() const { return new UnbinnedLikelihood( *this ); }
+
+      virtual unsigned int NDim() const { return nPar_; }
+
+      /// Integral of the shape (normalisation factor 1.) over the fit range
+      Double_t Integral( const double * x ) const
+      {
+        par_.assign( x, x + nPar_ );
+        par_[ 0 ] = 1.;
+        function_->Eval( nodes_.size(), &nodes_.front(), &par_.front(), &nodeValues_.front() );
+        Double_t integral( 0. );
+        for ( size_t k = 0; k < nodes_.size(); ++k ) integral += nodeWeights_[ k ] * nodeValues_[ k ];
+        return integral;
+      }
+
+      virtual void FdF( const double * x, double & f, double * grad ) const
+      {
+        f = DoEval( x );
+        for ( unsigned j = 0; j < nPar_; ++j ) grad[ j ] = 0.;
+        if ( f == invalidNLL ) return;
+        // DoEval() left the shape values in the buffers
+        for ( size_t i = 0; i < values_.size(); ++i ) {
+          Double_t xi( sample_->values[ i ] );
+          function_->Gradient( &xi, &par_.front(), &grad_.front() );
+          for ( unsigned j = 1; j < nPar_; ++j ) grad[ j ] -= weights_[ i ] * grad_[ j ] / values_[ i ];
+        }
+        Double_t integral( 0. );
+        std::vector< Double_t > gradIntegral( nPar_, 0. );
+        for ( size_t k = 0; k < nodes_.size(); ++k ) {
+          integral += nodeWeights_[ k ] * nodeValues_[ k ];
+          Double_t xk( nodes_[ k ] );
+          function_->Gradient( &xk, &par_.front(), &grad_.front() );
+          for ( unsigned j = 1; j < nPar_; ++j ) gradIntegral[ j ] += nodeWeights_[ k ] * grad_[ j ];
+        }
+        for ( unsigned j = 1; j < nPar_; ++j ) grad[ j ] += sumWeights_ * gradIntegral[ j ] / integral;
+      }
+
+      virtual void Gradient( const double * x, double * grad ) const
+      {
+        double f;
+        FdF( x, f, grad );
+      }
+
+    private:
+
+      virtual double DoEval( const double * x ) const
+      {
+        const Double_t integral( Integral( x ) );
+        if ( ! ( integral > 0. ) ) return invalidNLL;
+        function_->Eval( values_.size(), &sample_->values.front(), &par_.front(), &values_.front() );
+        Double_t nll( sumWeights_ * TMath::Log( integral ) );
+        for ( size_t i = 0; i < values_.size(); ++i ) {
+          if ( ! ( values_[ i ] > 0. ) ) return invalidNLL;
+          nll -= weights_[ i ] * TMath::Log( values_[ i ] );
+        }
+        return nll;
+      }
+
+      virtual double DoDerivative( const double * x, unsigned int icoord ) const
+      {
+        std::vector< double > grad( nPar_ );
+        Gradient( x, &grad.front() );
+        return grad[ icoord ];
+      }
+
+  };
+
+
+  /// Fits the rows of a cell grid
+  class UnbinnedGridBody {
+
+      const UnbinnedSampleGrid & samples_;
+      const UnbinnedSeedGrid & seeds_;
+      Function * ( *create_ )();
+      UnbinnedFitResultGrid * results_;
+
+    public:
+
+      UnbinnedGridBody( const UnbinnedSampleGrid & samples, const UnbinnedSeedGrid & seeds, Function * ( *create )(), UnbinnedFitResultGrid * results )
+      : samples_( samples )
+      , seeds_( seeds )
+      , create_( create )
+      , results_( results )
+      {}
+
+      void operator()( const tbb::blocked_range< size_t > & rows ) const
+      {
+        for ( size_t row = rows.begin(); row != rows.end(); ++row ) {
+          // each row has its own function, since the functions cache parameter dependent constants
+          std::auto_ptr< Function > function( create_() );
+          UnbinnedFitter fitter( function.get() );
+          const UnbinnedFitResult * last( 0 );
+          for ( size_t col = 0; col < samples_.at( row ).size(); ++col ) {
+            UnbinnedSeed seed( seeds_.at( row ).at( col ) );
+            if ( last != 0 && last->parameters.size() == seed.values.size() ) {
+              for ( size_t i = 1; i < seed.values.size(); ++i ) seed.values[ i ] = last->parameters[ i ];
+            }
+            UnbinnedFitResult & result( results_->at( row ).at( col ) );
+            result = fitter.Fit( samples_.at( row ).at( col ), seed );
+            if ( result.status == 0 ) last = &result;
+          }
+        }
+      }
+
+  };
+
+
+  /// Solves a * x = b for small, dense 'a' (Gaussian elimination with partial pivoting)
+  /// The solution replaces 'b'; returns false for singular 'a'.
+  bool solveLinear( std::vector< std::vector< Double_t > > a, std::vector< Double_t > & b )
+  {
+    const size_t n( b.size() );
+    for ( size_t col = 0; col < n; ++col ) {
+      size_t pivot( col );
+      for ( size_t row = col + 1; row < n; ++row ) {
+        if ( TMath::Abs( a[ row ][ col ] ) > TMath::Abs( a[ pivot ][ col ] ) ) pivot = row;
+      }
+      if ( a[ pivot ][ col ] == 0. ) return false;
+      std::swap( a[ col ], a[ pivot ] );
+      std::swap( b[ col ], b[ pivot ] );
+      for ( size_t row = col + 1; row < n; ++row ) {
+        const Double_t factor( a[ row ][ col ] / a[ col ][ col ] );
+        for ( size_t k = col; k < n; ++k ) a[ row ][ k ] -= factor * a[ col ][ k ];
+        b[ row ] -= factor * b[ col ];
+      }
+    }
+    for ( size_t col = n; col-- > 0; ) {
+      for ( size_t k = col + 1; k < n; ++k ) b[ col ] -= a[ col ][ k ] * b[ k ];
+      b[ col ] /= a[ col ][ col ];
+    }
+    return true;
+  }
+
+
+  /// Sum of squared residuals of the dependency function
+  Double_t chi2Dependency( Function * dependency, const std::vector< Double_t > & x, const std::vector< Double_t > & y, std::vector< Double_t > coefficients )
+  {
+    Double_t chi2( 0. );
+    for ( size_t k = 0; k < x.size(); ++k ) {
+      Double_t xk( x[ k ] );
+      const Double_t residual( y[ k ] - ( *dependency )( &xk, &coefficients.front() ) );
+      chi2 += residual * residual;
+    }
+    return chi2;
+  }
+
+
+  /// Start values of the dependency coefficients from a least squares fit (Levenberg-Marquardt)
+  /// to the values 'y' at the dependency values 'x'
+  /// The non-constant coefficients start slightly off 0., where the gradient of
+  /// e.g. my::ResolutionLike vanishes.
+  std::vector< Double_t > seedDependency( Function * dependency, const std::vector< Double_t > & x, const std::vector< Double_t > & y )
+  {
+    const unsigned nDep( dependency->NParameters() );
+    Double_t mean( 0. );
+    for ( size_t k = 0; k < y.size(); ++k ) mean += y[ k ];
+    if ( ! y.empty() ) mean /= y.size();
+    std::vector< Double_t > coefficients( nDep, 1.e-3 * ( mean != 0. ? TMath::Abs( mean ) : 1. ) );
+    coefficients[ 0 ] = mean;
+
+    Double_t chi2( chi2Dependency( dependency, x, y, coefficients ) );
+    Double_t lambda( 1.e-3 );
+    std::vector< Double_t > grad( nDep );
+    for ( unsigned iteration = 0; iteration < 100; ++iteration ) {
+      std::vector< std::vector< Double_t > > a( nDep, std::vector< Double_t >( nDep, 0. ) );
+      std::vector< Double_t > b( nDep, 0. );
+      for ( size_t k = 0; k < x.size(); ++k ) {
+        Double_t xk( x[ k ] );
+        const Double_t residual( y[ k ] - ( *dependency )( &xk, &coefficients.front() ) );
+        dependency->Gradient( &xk, &coefficients.front(), &grad.front() );
+        for ( unsigned i = 0; i < nDep; ++i ) {
+          for ( unsigned j = 0; j < nDep; ++j ) a[ i ][ j ] += grad[ i ] * grad[ j ];
+          b[ i ] += grad[ i ] * residual;
+        }
+      }
+      bool improved( false );
+      while ( ! improved && lambda < 1.e10 ) {
+        std::vector< std::vector< Double_t > > damped( a );
+        std::vector< Double_t > step( b );
+        for ( unsigned i = 0; i < nDep; ++i ) damped[ i ][ i ] += lambda * ( a[ i ][ i ] > 0. ? a[ i ][ i ] : 1. );
+        if ( solveLinear( damped, step ) ) {
+          std::vector< Double_t > trial( coefficients );
+          for ( unsigned i = 0; i < nDep; ++i ) trial[ i ] += step[ i ];
+          const Double_t chi2Trial( chi2Dependency( dependency, x, y, trial ) );
+          if ( chi2Trial < chi2 ) {
+            improved = true;
+            const bool converged( chi2 - chi2Trial <= 1.e-10 * chi2 );
+            coefficients = trial;
+            chi2 = chi2Trial;
+            lambda = std::max( 0.1 * lambda, 1.e-7 );
+            if ( converged ) return coefficients;
+            continue;
+          }
+        }
+        lambda *= 10.;
+      }
+      if ( ! improved ) break;
+    }
+    return coefficients;
+  }
+
+
+  /// Sum of the negative log-likelihoods of cells, whose shape parameters follow
+  /// the dependency function
+  /// The coefficients are ordered as [ i * nDep + j ] for coefficient j of fit parameter i.
+  /// The Jacobian of the cell parameters with respect to the coefficients is block
+  /// diagonal (parameter i depends only on its own coefficients), so the gradient
+  /// is accumulated per cell from its shape gradient and the dependency gradients.
+  class UnbinnedDependencyLikelihood : public ROOT::Math::IMultiGradFunction {
+
+      Function * dependency_;
+      unsigned nPar_;
+      unsigned nDep_;
+      std::vector< UnbinnedLikelihood > cells_;
+      std::vector< Double_t > dependencyValues_;
+      /// Buffers
+      mutable std::vector< Double_t > par_;
+      mutable std::vector< Double_t > coefficients_;
+      mutable std::vector< Double_t > cellGrad_;
+      mutable std::vector< Double_t > depGrad_;
+
+    public:
+
+      UnbinnedDependencyLikelihood( Function * function, Function * dependency, const std::vector< const UnbinnedSample * > & samples, const std::vector< Double_t > & dependencyValues, UInt_t nIntegration )
+      : dependency_( dependency )
+      , nPar_( function->NParameters() )
+      , nDep_( dependency->NParameters() )
+      , dependencyValues_( dependencyValues )
+      , par_( nPar_ )
+      , coefficients_( nDep_ )
+      , cellGrad_( nPar_ )
+      , depGrad_( nDep_ )
+      {
+        cells_.reserve( samples.size() );
+        for ( size_t c = 0; c < samples.size(); ++c ) cells_.push_back( UnbinnedLikelihood( function, *( samples[ c ] ), nIntegration ) );
+      }
+
+      virtual ROOT::Math::IMultiGenFunction * Clone() const { return new UnbinnedDependencyLikelihood( *this ); }
+
+      virtual unsigned int NDim() const { return nPar_ * nDep_; }
+
+      virtual void FdF( const double * x, double & f, double * grad ) const
+      {
+        f = 0.;
+        for ( unsigned k = 0; k < NDim(); ++k ) grad[ k ] = 0.;
+        for ( size_t c = 0; c < cells_.size(); ++c ) {
+          CellParameters( c, x );
+          double fCell;
+          cells_[ c ].FdF( &par_.front(), fCell, &cellGrad_.front() );
+          if ( fCell == invalidNLL ) {
+            f = invalidNLL;
+            for ( unsigned k = 0; k < NDim(); ++k ) grad[ k ] = 0.;
+            return;
+          }
+          f += fCell;
+          Double_t value( dependencyValues_[ c ] );
+          for ( unsigned i = 1; i < nPar_; ++i ) {
+            coefficients_.assign( x + i * nDep_, x + ( i + 1 ) * nDep_ );
+            dependency_->Gradient( &value, &coefficients_.front(), &depGrad_.front() );
+            for ( unsigned j = 0; j < nDep_; ++j ) grad[ i * nDep_ + j ] += cellGrad_[ i ] * depGrad_[ j ];
+          }
+        }
+      }
+
+      virtual void Gradient( const double * x, double * grad ) const
+      {
+        double f;
+        FdF( x, f, grad );
+      }
+
+    private:
+
+      /// Evaluates the shape parameters of cell 'c' into the buffer
+      void CellParameters( size_t c, const double * x ) const
+      {
+        Double_t value( dependencyValues_[ c ] );
+        par_[ 0 ] = 1.;
+        for ( unsigned i = 1; i < nPar_; ++i ) {
+          coefficients_.assign( x + i * nDep_, x + ( i + 1 ) * nDep_ );
+          par_[ i ] = ( *dependency_ )( &value, &coefficients_.front() );
+        }
+      }
+
+      virtual double DoEval( const double * x ) const
+      {
+        Double_t nll( 0. );
+        for ( size_t c = 0; c < cells_.size(); ++c ) {
+          CellParameters( c, x );
+          const Double_t nllCell( cells_[ c ]( &par_.front() ) );
+          if ( nllCell == invalidNLL ) return invalidNLL;
+          nll += nllCell;
+        }
+        return nll;
+      }
+
+      virtual double DoDerivative( const double * x, unsigned int icoord ) const
+      {
+        std::vector< double > grad( NDim() );
+        Gradient( x, &grad.front() );
+        return grad[ icoord ];
+      }
+
+  };
+
+
+  /// Runs the joint fits of the rows and of the full grid
+  /// Task 0, the largest fit, is the full grid; task t > 0 is row t - 1.
+  class UnbinnedDependencyGridBody {
+
+      const UnbinnedSampleGrid & samples_;
+      const UnbinnedValueGrid & dependencyValues_;
+      const UnbinnedSeedGrid & seeds_;
+      Function * ( *createFit_ )();
+      Function * ( *createDependency_ )();
+      Double_t minDependency_;
+      Double_t maxDependency_;
+      std::vector< UnbinnedDependencyFitResult > * results_;
+
+    public:
+
+      UnbinnedDependencyGridBody( const UnbinnedSampleGrid & samples, const UnbinnedValueGrid & dependencyValues, const UnbinnedSeedGrid & seeds, Function * ( *createFit )(), Function * ( *createDependency )(), Double_t minDependency, Double_t maxDependency, std::vector< UnbinnedDependencyFitResult > * results )
+      : samples_( samples )
+      , dependencyValues_( dependencyValues )
+      , seeds_( seeds )
+      , createFit_( createFit )
+      , createDependency_( createDependency )
+      , minDependency_( minDependency )
+      , maxDependency_( maxDependency )
+      , results_( results )
+      {}
+
+      void operator()( const tbb::blocked_range< size_t > & tasks ) const
+      {
+        for ( size_t task = tasks.begin(); task != tasks.end(); ++task ) {
+          std::auto_ptr< Function > function( createFit_() );
+          std::auto_ptr< Function > dependency( createDependency_() );
+          UnbinnedDependencyFitter fitter( function.get(), dependency.get(), minDependency_, maxDependency_ );
+          if ( task == 0 ) {
+            results_->back() = fitter.Fit( samples_, dependencyValues_, seeds_ );
+          }
+          else {
+            results_->at( task - 1 ) = fitter.Fit( samples_.at( task - 1 ), dependencyValues_.at( task - 1 ), seeds_.at( task - 1 ) );
+          }
+        }
+      }
+
+  };
+
+}
+
+
+// Constructors and Destructor
+
+// Constructor from the function to fit
+UnbinnedFitter::UnbinnedFitter( Function * function, UInt_t nIntegration )
+: function_( function )
+, nIntegration_( nIntegration )
+{
+}
+
+// Constructor from the function to fit and the dependency function of its parameters
+UnbinnedDependencyFitter::UnbinnedDependencyFitter( Function * function, Function * dependency, Double_t minDependency, Double_t maxDependency, UInt_t nIntegration )
+: function_( function )
+, dependency_( dependency )
+, minDependency_( minDependency )
+, maxDependency_( maxDependency )
+, nIntegration_( nIntegration )
+{
+}
+
+
+// Methods
+
+// Fits the function to the sample
+UnbinnedFitResult UnbinnedFitter::Fit( const UnbinnedSample & sample, const UnbinnedSeed & seed ) const
+{
+  UnbinnedFitResult result;
+  const unsigned nPar( function_->NParameters() );
+  if ( sample.values.empty() || sample.values.size() != sample.weights.size() || ! ( sample.max > sample.min ) || seed.values.size() != nPar ) return result;
+
+  UnbinnedLikelihood nll( function_, sample, nIntegration_ );
+  ROOT::Minuit2::Minuit2Minimizer minimizer( ROOT::Minuit2::kMigrad );
+  minimizer.SetPrintLevel( 0 );
+  minimizer.SetErrorDef( 0.5 );
+  minimizer.SetFunction( nll );
+  minimizer.SetFixedVariable( 0, "p0", 1. );
+  for ( unsigned i = 1; i < nPar; ++i ) {
+    const std::string name( "p" + boost::lexical_cast< std::string >( i ) );
+    const bool limited( i < seed.lower.size() && i < seed.upper.size() && seed.lower[ i ] < seed.upper[ i ] );
+    Double_t start( seed.values[ i ] );
+    Double_t step( start != 0. ? 0.1 * TMath::Abs( start ) : 0.1 );
+    if ( limited ) {
+      start = std::min( std::max( start, seed.lower[ i ] ), seed.upper[ i ] );
+      step  = std::min( step, 0.1 * ( seed.upper[ i ] - seed.lower[ i ] ) );
+      minimizer.SetLimitedVariable( i, name, start, step, seed.lower[ i ], seed.upper[ i ] );
+    }
+    else {
+      minimizer.SetVariable( i, name, start, step );
+    }
+  }
+  minimizer.Minimize();
+
+  result.status = minimizer.Status();
+  result.nll    = minimizer.MinValue();
+  result.parameters.assign( minimizer.X(), minimizer.X() + nPar );
+  result.errors.assign( minimizer.Errors(), minimizer.Errors() + nPar );
+
+  // Normalisation: sum of weights extrapolated to the full shape
+  Double_t sumWeights( 0. );
+  Double_t sumWeights2( 0. );
+  for ( size_t i = 0; i < sample.weights.size(); ++i ) {
+    sumWeights  += sample.weights[ i ];
+    sumWeights2 += sample.weights[ i ] * sample.weights[ i ];
+  }
+  const Double_t integral( nll.Integral( minimizer.X() ) );
+  if ( integral > 0. ) {
+    result.parameters[ 0 ] = sumWeights / integral;
+    result.errors[ 0 ]     = TMath::Sqrt( sumWeights2 ) / integral;
+  }
+
+  return result;
+}
+
+
+// Fits the dependency coefficients to the cells of a row
+UnbinnedDependencyFitResult UnbinnedDependencyFitter::Fit( const std::vector< UnbinnedSample > & samples, const std::vector< Double_t > & dependencyValues, const std::vector< UnbinnedSeed > & seeds ) const
+{
+  std::vector< const UnbinnedSample * > cellSamples;
+  std::vector< const UnbinnedSeed * > cellSeeds;
+  for ( size_t col = 0; col < samples.size(); ++col ) {
+    cellSamples.push_back( &samples.at( col ) );
+    cellSeeds.push_back( &seeds.at( col ) );
+  }
+  return Fit( cellSamples, dependencyValues, cellSeeds );
+}
+
+// Fits the dependency coefficients to all cells of a grid
+UnbinnedDependencyFitResult UnbinnedDependencyFitter::Fit( const UnbinnedSampleGrid & samples, const UnbinnedValueGrid & dependencyValues, const UnbinnedSeedGrid & seeds ) const
+{
+  std::vector< const UnbinnedSample * > cellSamples;
+  std::vector< Double_t > cellValues;
+  std::vector< const UnbinnedSeed * > cellSeeds;
+  for ( size_t row = 0; row < samples.size(); ++row ) {
+    for ( size_t col = 0; col < samples.at( row ).size(); ++col ) {
+      cellSamples.push_back( &samples.at( row ).at( col ) );
+      cellValues.push_back( dependencyValues.at( row ).at( col ) );
+      cellSeeds.push_back( &seeds.at( row ).at( col ) );
+    }
+  }
+  return Fit( cellSamples, cellValues, cellSeeds );
+}
+
+// Fits the dependency coefficients to the cells
+UnbinnedDependencyFitResult UnbinnedDependencyFitter::Fit( const std::vector< const UnbinnedSample * > & samples, const std::vector< Double_t > & dependencyValues, const std::vector< const UnbinnedSeed * > & seeds ) const
+{
+  UnbinnedDependencyFitResult result;
+  const unsigned nPar( function_->NParameters() );
+  const unsigned nDep( dependency_->NParameters() );
+
+  // Usable cells and their seed values per fit parameter
+  std::vector< const UnbinnedSample * > cells;
+  std::vector< Double_t > values;
+  std::vector< std::vector< Double_t > > seedValues( nPar );
+  for ( size_t c = 0; c < samples.size(); ++c ) {
+    const UnbinnedSample & sample( *( samples.at( c ) ) );
+    if ( sample.values.empty() || sample.values.size() != sample.weights.size() || ! ( sample.max > sample.min ) || seeds.at( c )->values.size() != nPar ) continue;
+    if ( dependencyValues.at( c ) < minDependency_ || dependencyValues.at( c ) > maxDependency_ ) continue;
+    cells.push_back( &sample );
+    values.push_back( dependencyValues.at( c ) );
+    for ( unsigned i = 0; i < nPar; ++i ) seedValues[ i ].push_back( seeds.at( c )->values[ i ] );
+  }
+  result.nCells = cells.size();
+  if ( cells.size() < nDep ) return result;
+
+  UnbinnedDependencyLikelihood nll( function_, dependency_, cells, values, nIntegration_ );
+  ROOT::Minuit2::Minuit2Minimizer minimizer( ROOT::Minuit2::kMigrad );
+  minimizer.SetPrintLevel( 0 );
+  minimizer.SetErrorDef( 0.5 );
+  minimizer.SetFunction( nll );
+  for ( unsigned i = 0; i < nPar; ++i ) {
+    const std::vector< Double_t > start( i == 0 ? std::vector< Double_t >( nDep, 0. ) : seedDependency( dependency_, values, seedValues[ i ] ) );
+    for ( unsigned j = 0; j < nDep; ++j ) {
+      const std::string name( "p" + boost::lexical_cast< std::string >( i ) + "_" + boost::lexical_cast< std::string >( j ) );
+      if ( i == 0 ) {
+        minimizer.SetFixedVariable( i * nDep + j, name, 0. );
+      }
+      else {
+        minimizer.SetVariable( i * nDep + j, name, start[ j ], start[ j ] != 0. ? 0.1 * TMath::Abs( start[ j ] ) : 0.1 );
+      }
+    }
+  }
+  minimizer.Minimize();
+
+  result.status = minimizer.Status();
+  result.nll    = minimizer.MinValue();
+  for ( unsigned i = 0; i < nPar; ++i ) {
+    result.coefficients.push_back( std::vector< Double_t >( minimizer.X() + i * nDep, minimizer.X() + ( i + 1 ) * nDep ) );
+    result.errors.push_back( std::vector< Double_t >( minimizer.Errors() + i * nDep, minimizer.Errors() + ( i + 1 ) * nDep ) );
+  }
+
+  return result;
+}
+
+
+// Functions
+
+// Fits all cells of a grid
+UnbinnedFitResultGrid my::fitUnbinnedGrid( const UnbinnedSampleGrid & samples, const UnbinnedSeedGrid & seeds, Function * ( *create )(), unsigned nThreads )
+{
+  UnbinnedFitResultGrid results;
+  results.reserve( samples.size() );
+  for ( size_t row = 0; row < samples.size(); ++row ) results.push_back( std::vector< UnbinnedFitResult >( samples.at( row ).size() ) );
+
+  UnbinnedGridBody body( samples, seeds, create, &results );
+  if ( nThreads == 1 ) {
+    body( tbb::blocked_range< size_t >( 0, samples.size() ) );
+  }
+  else {
+    SuppressInfoMessages suppress;
+    tbb::task_scheduler_init init( nThreads == 0 ? int( tbb::task_scheduler_init::automatic ) : int( nThreads ) );
+    tbb::parallel_for( tbb::blocked_range< size_t >( 0, samples.size(), 1 ), body );
+  }
+
+  return results;
+}
+
+// Joint fits of the dependency coefficients of all rows and of the full grid
+std::vector< UnbinnedDependencyFitResult > my::fitUnbinnedDependencyGrid( const UnbinnedSampleGrid & samples, const UnbinnedValueGrid & dependencyValues, const UnbinnedSeedGrid & seeds, Function * ( *createFit )(), Function * ( *createDependency )(), Double_t minDependency, Double_t maxDependency, unsigned nThreads )
+{
+  std::vector< UnbinnedDependencyFitResult > results( samples.size() + 1 );
+
+  UnbinnedDependencyGridBody body( samples, dependencyValues, seeds, createFit, createDependency, minDependency, maxDependency, &results );
+  if ( nThreads == 1 ) {
+    body( tbb::blocked_range< size_t >( 0, results.size() ) );
+  }
+  else {
+    SuppressInfoMessages suppress;
+    tbb::task_scheduler_init init( nThreads == 0 ? int( tbb::task_scheduler_init::automatic ) : int( nThreads ) );
+    tbb::parallel_for( tbb::blocked_range< size_t >( 0, results.size(), 1 ), body );
+  }
+
+  return results;
+}
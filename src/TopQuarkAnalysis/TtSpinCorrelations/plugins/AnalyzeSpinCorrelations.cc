@@ -7,16 +7,18 @@
 //
 /**
   \class    AnalyzeSpinCorrelations AnalyzeSpinCorrelations.cc "TopQuarkAnalysis/TtSpinCorrelations/plugins/AnalyzeSpinCorrelations.cc"
-  \brief
-
+  \brief    Fill and fit histograms of spin correlation observables in semi-leptonic ttbar events
 
+   The histograms are booked into arrays indexed by the enumerations below, so
+   that filling them needs no look-up. All decay products are boosted into the
+   ttbar CM frame and on into their top quark's rest frame by
+   'boostInPlace()', which computes the boost factors once per frame.
 
   \author   Volker Adler
   \version  $Id:$
 */
 
 
-#include <map>
 #include <string>
 
 #include "TH1D.h"
@@ -58,6 +60,18 @@ class AnalyzeSpinCorrelations : public edm::EDAnalyzer {
 
   private:
 
+    /// Histogram and particle indices
+    // Spin bases
+    enum Basis { kHel, kBeam, kOffDiag, nBases };
+    // Basis independent 1-dim histograms
+    enum Histo1D { kMassTt, kCosLB, kCosLQ, nHistos1D };
+    // 1-dim histograms per spin basis
+    enum HistoBasis1D { kCosTL, kCosTB, kCosTQ, nHistosBasis1D };
+    // 2-dim histograms per spin basis
+    enum HistoBasis2D { kCosTBCosTL, kCosTQCosTL, nHistosBasis2D };
+    // Boosted 4-vectors
+    enum Particle { kTLeptonic, kTHadronic, kLLeptonic, kBHadronic, kQ1Hadronic, kQ2Hadronic, kBeamParton, nParticles };
+
     /// Data members
     // TQAF semi-leptonic event
     edm::Handle< TtSemiLeptonicEvent > ttSemiLeptonicEvent_;
@@ -70,10 +84,8 @@ class AnalyzeSpinCorrelations : public edm::EDAnalyzer {
     // Leptons to use
     bool useMuons_;
     bool useElecs_;
-    // Spin basis to use
-    bool useHelBasis_;
-    bool useBeamBasis_;
-    bool useOffDiagBasis_;
+    // Spin bases to use
+    bool useBasis_[ nBases ];
     // Histogram settings
     unsigned binsMassTt_;
     double   minMassTt_;
@@ -87,19 +99,15 @@ class AnalyzeSpinCorrelations : public edm::EDAnalyzer {
 
     /// Histograms
     // 1-dim
-    std::map< std::string, TH1D* > histos1D_;
-    std::map< std::string, TH1D* > histos1D_Hel_;
-    std::map< std::string, TH1D* > histos1D_Beam_;
-    std::map< std::string, TH1D* > histos1D_OffDiag_;
+    TH1D * histos1D_[ nHistos1D ];
+    TH1D * histosBasis1D_[ nBases ][ nHistosBasis1D ];
     // 2-dim
-    std::map< std::string, TH2D* > histos2D_Hel_;
-    std::map< std::string, TH2D* > histos2D_Beam_;
-    std::map< std::string, TH2D* > histos2D_OffDiag_;
+    TH2D * histosBasis2D_[ nBases ][ nHistosBasis2D ];
 
 };
 
 
-#include "Math/GenVector/VectorUtil.h"
+#include <cmath>
 
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 #include "FWCore/ServiceRegistry/interface/Service.h"
@@ -115,9 +123,6 @@ AnalyzeSpinCorrelations::AnalyzeSpinCorrelations( const edm::ParameterSet & iCon
 , ttSemiLeptonicEventTag_( iConfig.getParameter< edm::InputTag >( "ttSemiLeptonicEvent" ) )
 , useMuons_( iConfig.getParameter< bool >( "useMuons" ) )
 , useElecs_( iConfig.getParameter< bool >( "useElectrons" ) )
-, useHelBasis_(iConfig.getParameter< bool >( "useHelicityBasis" ) )
-, useBeamBasis_(iConfig.getParameter< bool >( "useBeamBasis" ) )
-, useOffDiagBasis_(iConfig.getParameter< bool > ( "useOffDiagonalBasis" ) )
 , binsMassTt_(iConfig.getParameter< unsigned >( "binsMassTt" ) )
 , minMassTt_(iConfig.getParameter< double >( "minMassTt" ) )
 , maxMassTt_(iConfig.getParameter< double >( "maxMassTt" ) )
@@ -127,6 +132,45 @@ AnalyzeSpinCorrelations::AnalyzeSpinCorrelations( const edm::ParameterSet & iCon
 , kappaB_(iConfig.getParameter< double >( "kappaB" ) )
 , kappaQ_(iConfig.getParameter< double >( "kappaQ" ) )
 {
+
+  useBasis_[ kHel ]     = iConfig.getParameter< bool >( "useHelicityBasis" );
+  useBasis_[ kBeam ]    = iConfig.getParameter< bool >( "useBeamBasis" );
+  useBasis_[ kOffDiag ] = iConfig.getParameter< bool >( "useOffDiagonalBasis" );
+
+  for ( unsigned iHisto = 0; iHisto < nHistos1D; ++iHisto ) histos1D_[ iHisto ] = 0;
+  for ( unsigned iBasis = 0; iBasis < nBases; ++iBasis ) {
+    for ( unsigned iHisto = 0; iHisto < nHistosBasis1D; ++iHisto ) histosBasis1D_[ iBasis ][ iHisto ] = 0;
+    for ( unsigned iHisto = 0; iHisto < nHistosBasis2D; ++iHisto ) histosBasis2D_[ iBasis ][ iHisto ] = 0;
+  }
+
+}
+
+
+namespace {
+
+  /// Boosts 'n' 4-vectors in place by 'beta' (as ROOT::Math::VectorUtil::boost),
+  /// computing the boost factors only once
+  void boostInPlace( reco::Particle::LorentzVector * p4s, unsigned n, const reco::Particle::LorentzVector::BetaVector & beta )
+  {
+    const double bx( beta.X() );
+    const double by( beta.Y() );
+    const double bz( beta.Z() );
+    const double b2( bx * bx + by * by + bz * bz );
+    const double gamma( 1. / std::sqrt( 1. - b2 ) );
+    const double gamma2( b2 > 0. ? ( gamma - 1. ) / b2 : 0. );
+    for ( unsigned i = 0; i < n; ++i ) {
+      const double x( p4s[ i ].Px() );
+      const double y( p4s[ i ].Py() );
+      const double z( p4s[ i ].Pz() );
+      const double t( p4s[ i ].E() );
+      const double bp( bx * x + by * y + bz * z );
+      p4s[ i ].SetPxPyPzE( x + gamma2 * bp * bx + gamma * bx * t
+                         , y + gamma2 * bp * by + gamma * by * t
+                         , z + gamma2 * bp * bz + gamma * bz * t
+                         , gamma * ( t + bp ) );
+    }
+  }
+
 }
 
 
@@ -137,77 +181,42 @@ void AnalyzeSpinCorrelations::beginJob()
   edm::Service< TFileService > fileService;
 
   // tt mass
-  histos1D_[ "massTt" ] = fileService->make< TH1D >( "massTt", "t#bar{t} invariant mass", binsMassTt_, minMassTt_, maxMassTt_ );
-  histos1D_[ "massTt" ]->SetXTitle( "m_{t#bar{t}} (GeV)" );
-  histos1D_[ "massTt" ]->SetYTitle( "events" );
-  histos1D_[ "cosLB" ] = fileService->make< TH1D >( "cosLB", "Angle between lepton and b-quark", binsCos1D_, -1., 1. );
-  histos1D_[ "cosLB" ]->SetXTitle( "cos #phi_{l,b}" );
-  histos1D_[ "cosLB" ]->SetYTitle( "events" );
-  histos1D_[ "cosLQ" ] = fileService->make< TH1D >( "cosLQ", "Angle between lepton and low-energy light quark", binsCos1D_, -1., 1. );
-  histos1D_[ "cosLQ" ]->SetXTitle( "cos #phi_{l,q}" );
-  histos1D_[ "cosLQ" ]->SetYTitle( "events" );
-
-  if ( useHelBasis_ ) {
-    TFileDirectory dirHel( fileService->mkdir( "helicityBasis", "Helicity basis" ) );
-    histos1D_Hel_[ "cosTL" ] = dirHel.make< TH1D >( "cosLT_Hel", "Helicity basis: pseudo-angle between t-quark and lepton", binsCos1D_, -1., 1. );
-    histos1D_Hel_[ "cosTL" ]->SetXTitle( "cos #theta_{t,l}" );
-    histos1D_Hel_[ "cosTL" ]->SetYTitle( "events" );
-    histos1D_Hel_[ "cosTB" ] = dirHel.make< TH1D >( "cosLB_Hel", "Helicity basis: pseudo-angle between t-quark and b-quark", binsCos1D_, -1., 1. );
-    histos1D_Hel_[ "cosTB" ]->SetXTitle( "cos #theta_{t,b}" );
-    histos1D_Hel_[ "cosTB" ]->SetYTitle( "events" );
-    histos1D_Hel_[ "cosTQ" ] = dirHel.make< TH1D >( "cosLQ_Hel", "Helicity basis: pseudo-angle between t-quark and low-energy light quark", binsCos1D_, -1., 1. );
-    histos1D_Hel_[ "cosTQ" ]->SetXTitle( "cos #theta_{t,q}" );
-    histos1D_Hel_[ "cosTQ" ]->SetYTitle( "events" );
-    histos2D_Hel_[ "cosTBCosTL" ] = dirHel.make< TH2D >( "cosTBCosTL_Hel", "Helicity basis: pseudo-angles between t-quark and lepton/b-quark", binsCos2D_, -1., 1., binsCos2D_, -1., 1. );
-    histos2D_Hel_[ "cosTBCosTL" ]->SetXTitle( "cos #theta_{t,l}" );
-    histos2D_Hel_[ "cosTBCosTL" ]->SetYTitle( "cos #theta_{t,b}" );
-    histos2D_Hel_[ "cosTBCosTL" ]->SetZTitle( "events" );
-    histos2D_Hel_[ "cosTQCosTL" ] = dirHel.make< TH2D >( "cosTQCosTL_Hel", "Helicity basis: pseudo-angles between t-quark and lepton/low-energy quark", binsCos2D_, -1., 1., binsCos2D_, -1., 1. );
-    histos2D_Hel_[ "cosTQCosTL" ]->SetXTitle( "cos #theta_{t,l}" );
-    histos2D_Hel_[ "cosTQCosTL" ]->SetYTitle( "cos #theta_{t,q}" );
-    histos2D_Hel_[ "cosTQCosTL" ]->SetZTitle( "events" );
-  }
-
-  if ( useBeamBasis_ ) {
-    TFileDirectory dirBeam( fileService->mkdir( "beamBasis", "Beam basis" ) );
-    histos1D_Beam_[ "cosTL" ] = dirBeam.make< TH1D >( "cosLT_Beam", "Beam basis: pseudo-angle between t-quark and lepton", binsCos1D_, -1., 1. );
-    histos1D_Beam_[ "cosTL" ]->SetXTitle( "cos #theta_{t,l}" );
-    histos1D_Beam_[ "cosTL" ]->SetYTitle( "events" );
-    histos1D_Beam_[ "cosTB" ] = dirBeam.make< TH1D >( "cosLB_Beam", "Beam basis: pseudo-angle between t-quark and b-quark", binsCos1D_, -1., 1. );
-    histos1D_Beam_[ "cosTB" ]->SetXTitle( "cos #theta_{t,b}" );
-    histos1D_Beam_[ "cosTB" ]->SetYTitle( "events" );
-    histos1D_Beam_[ "cosTQ" ] = dirBeam.make< TH1D >( "cosLQ_Beam", "Beam basis: pseudo-angle between t-quark and low-energy light quark", binsCos1D_, -1., 1. );
-    histos1D_Beam_[ "cosTQ" ]->SetXTitle( "cos #theta_{t,q}" );
-    histos1D_Beam_[ "cosTQ" ]->SetYTitle( "events" );
-    histos2D_Beam_[ "cosTBCosTL" ] = dirBeam.make< TH2D >( "cosTBCosTL_Beam", "Beam basis: pseudo-angles between t-quark and lepton/b-quark", binsCos2D_, -1., 1., binsCos2D_, -1., 1. );
-    histos2D_Beam_[ "cosTBCosTL" ]->SetXTitle( "cos #theta_{t,l}" );
-    histos2D_Beam_[ "cosTBCosTL" ]->SetYTitle( "cos #theta_{t,b}" );
-    histos2D_Beam_[ "cosTBCosTL" ]->SetZTitle( "events" );
-    histos2D_Beam_[ "cosTQCosTL" ] = dirBeam.make< TH2D >( "cosTQCosTL_Beam", "Beam basis: pseudo-angles between t-quark and lepton/low-energy quark", binsCos2D_, -1., 1., binsCos2D_, -1., 1. );
-    histos2D_Beam_[ "cosTQCosTL" ]->SetXTitle( "cos #theta_{t,l}" );
-    histos2D_Beam_[ "cosTQCosTL" ]->SetYTitle( "cos #theta_{t,q}" );
-    histos2D_Beam_[ "cosTQCosTL" ]->SetZTitle( "events" );
-  }
-
-  if ( useOffDiagBasis_ ) {
-    TFileDirectory dirOffDiag( fileService->mkdir( "offDiagBasis", "Off-diagonal basis" ) );
-    histos1D_OffDiag_[ "cosTL" ] = dirOffDiag.make< TH1D >( "cosLT_OffDiag", "Off-diagonal basis: pseudo-angle between t-quark and lepton", binsCos1D_, -1., 1. );
-    histos1D_OffDiag_[ "cosTL" ]->SetXTitle( "cos #theta_{t,l}" );
-    histos1D_OffDiag_[ "cosTL" ]->SetYTitle( "events" );
-    histos1D_OffDiag_[ "cosTB" ] = dirOffDiag.make< TH1D >( "cosLB_OffDiag", "Off-diagonal basis: pseudo-angle between t-quark and b-quark", binsCos1D_, -1., 1. );
-    histos1D_OffDiag_[ "cosTB" ]->SetXTitle( "cos #theta_{t,b}" );
-    histos1D_OffDiag_[ "cosTB" ]->SetYTitle( "events" );
-    histos1D_OffDiag_[ "cosTQ" ] = dirOffDiag.make< TH1D >( "cosLQ_OffDiag", "Off-diagonal basis: pseudo-angle between t-quark and low-energy light quark", binsCos1D_, -1., 1. );
-    histos1D_OffDiag_[ "cosTQ" ]->SetXTitle( "cos #theta_{t,q}" );
-    histos1D_OffDiag_[ "cosTQ" ]->SetYTitle( "events" );
-    histos2D_OffDiag_[ "cosTBCosTL" ] = dirOffDiag.make< TH2D >( "cosTBCosTL_OffDiag", "Off-diagonal basis: pseudo-angles between t-quark and lepton/b-quark", binsCos2D_, -1., 1., binsCos2D_, -1., 1. );
-    histos2D_OffDiag_[ "cosTBCosTL" ]->SetXTitle( "cos #theta_{t,l}" );
-    histos2D_OffDiag_[ "cosTBCosTL" ]->SetYTitle( "cos #theta_{t,b}" );
-    histos2D_OffDiag_[ "cosTBCosTL" ]->SetZTitle( "events" );
-    histos2D_OffDiag_[ "cosTQCosTL" ] = dirOffDiag.make< TH2D >( "cosTQCosTL_OffDiag", "Off-diagonal basis: pseudo-angles between t-quark and lepton/low-energy quark", binsCos2D_, -1., 1., binsCos2D_, -1., 1. );
-    histos2D_OffDiag_[ "cosTQCosTL" ]->SetXTitle( "cos #theta_{t,l}" );
-    histos2D_OffDiag_[ "cosTQCosTL" ]->SetYTitle( "cos #theta_{t,q}" );
-    histos2D_OffDiag_[ "cosTQCosTL" ]->SetZTitle( "events" );
+  histos1D_[ kMassTt ] = fileService->make< TH1D >( "massTt", "t#bar{t} invariant mass", binsMassTt_, minMassTt_, maxMassTt_ );
+  histos1D_[ kMassTt ]->SetXTitle( "m_{t#bar{t}} (GeV)" );
+  histos1D_[ kMassTt ]->SetYTitle( "events" );
+  histos1D_[ kCosLB ] = fileService->make< TH1D >( "cosLB", "Angle between lepton and b-quark", binsCos1D_, -1., 1. );
+  histos1D_[ kCosLB ]->SetXTitle( "cos #phi_{l,b}" );
+  histos1D_[ kCosLB ]->SetYTitle( "events" );
+  histos1D_[ kCosLQ ] = fileService->make< TH1D >( "cosLQ", "Angle between lepton and low-energy light quark", binsCos1D_, -1., 1. );
+  histos1D_[ kCosLQ ]->SetXTitle( "cos #phi_{l,q}" );
+  histos1D_[ kCosLQ ]->SetYTitle( "events" );
+
+  const std::string dirNames[ nBases ]   = { "helicityBasis", "beamBasis", "offDiagBasis" };
+  const std::string basisNames[ nBases ] = { "Helicity basis", "Beam basis", "Off-diagonal basis" };
+  const std::string suffixes[ nBases ]   = { "_Hel", "_Beam", "_OffDiag" };
+  const std::string names1D[ nHistosBasis1D ]  = { "cosLT", "cosLB", "cosLQ" };
+  const std::string titles1D[ nHistosBasis1D ] = { "pseudo-angle between t-quark and lepton", "pseudo-angle between t-quark and b-quark", "pseudo-angle between t-quark and low-energy light quark" };
+  const std::string axes1D[ nHistosBasis1D ]   = { "cos #theta_{t,l}", "cos #theta_{t,b}", "cos #theta_{t,q}" };
+  const std::string names2D[ nHistosBasis2D ]  = { "cosTBCosTL", "cosTQCosTL" };
+  const std::string titles2D[ nHistosBasis2D ] = { "pseudo-angles between t-quark and lepton/b-quark", "pseudo-angles between t-quark and lepton/low-energy quark" };
+  const std::string axes2D[ nHistosBasis2D ]   = { "cos #theta_{t,b}", "cos #theta_{t,q}" };
+
+  for ( unsigned iBasis = 0; iBasis < nBases; ++iBasis ) {
+    if ( ! useBasis_[ iBasis ] ) continue;
+    TFileDirectory dir( fileService->mkdir( dirNames[ iBasis ].c_str(), basisNames[ iBasis ].c_str() ) );
+    for ( unsigned iHisto = 0; iHisto < nHistosBasis1D; ++iHisto ) {
+      TH1D * histo( dir.make< TH1D >( std::string( names1D[ iHisto ] + suffixes[ iBasis ] ).c_str(), std::string( basisNames[ iBasis ] + ": " + titles1D[ iHisto ] ).c_str(), binsCos1D_, -1., 1. ) );
+      histo->SetXTitle( axes1D[ iHisto ].c_str() );
+      histo->SetYTitle( "events" );
+      histosBasis1D_[ iBasis ][ iHisto ] = histo;
+    }
+    for ( unsigned iHisto = 0; iHisto < nHistosBasis2D; ++iHisto ) {
+      TH2D * histo( dir.make< TH2D >( std::string( names2D[ iHisto ] + suffixes[ iBasis ] ).c_str(), std::string( basisNames[ iBasis ] + ": " + titles2D[ iHisto ] ).c_str(), binsCos2D_, -1., 1., binsCos2D_, -1., 1. ) );
+      histo->SetXTitle( "cos #theta_{t,l}" );
+      histo->SetYTitle( axes2D[ iHisto ].c_str() );
+      histo->SetZTitle( "events" );
+      histosBasis2D_[ iBasis ][ iHisto ] = histo;
+    }
   }
 
 }
@@ -232,74 +241,55 @@ void AnalyzeSpinCorrelations::analyze( const edm::Event & iEvent, const edm::Eve
            ( ttGenEvent_->isSemiLeptonic( WDecay::kElec ) && useElecs_ ) ) ) {
 
       // build CM sytem
-      reco::Particle::LorentzVector topPairCmf( ttGenEvent_->top()->p4() + ttGenEvent_->topBar()->p4() );
+      const reco::Particle::LorentzVector topPairCmf( ttGenEvent_->top()->p4() + ttGenEvent_->topBar()->p4() );
 
       // boost particle 4-vectors to tt Cmf
-      reco::Particle::LorentzVector tLeptonicCmf( ROOT::Math::VectorUtil::boost( ttGenEvent_->leptonicDecayTop()->p4(), topPairCmf.BoostToCM() ) );
-      reco::Particle::LorentzVector tHadronicCmf( ROOT::Math::VectorUtil::boost( ttGenEvent_->hadronicDecayTop()->p4(), topPairCmf.BoostToCM() ) );
-      reco::Particle::LorentzVector lLeptonicCmf( ROOT::Math::VectorUtil::boost( ttGenEvent_->singleLepton()->p4(), topPairCmf.BoostToCM() ) );
-      reco::Particle::LorentzVector bHadronicCmf( ROOT::Math::VectorUtil::boost( ttGenEvent_->hadronicDecayB()->p4(), topPairCmf.BoostToCM() ) );
-      reco::Particle::LorentzVector q1HadronicCmf( ROOT::Math::VectorUtil::boost( ttGenEvent_->hadronicDecayQuark()->p4(), topPairCmf.BoostToCM() ) );
-      reco::Particle::LorentzVector q2HadronicCmf( ROOT::Math::VectorUtil::boost( ttGenEvent_->hadronicDecayQuarkBar()->p4(), topPairCmf.BoostToCM() ) );
-      reco::Particle::LorentzVector beamCmf(ROOT::Math::VectorUtil::boost( ( ttGenEvent_->initialPartons() )[0].p4(), topPairCmf.BoostToCM() ) );
+      reco::Particle::LorentzVector p4s[ nParticles ];
+      p4s[ kTLeptonic ]  = ttGenEvent_->leptonicDecayTop()->p4();
+      p4s[ kTHadronic ]  = ttGenEvent_->hadronicDecayTop()->p4();
+      p4s[ kLLeptonic ]  = ttGenEvent_->singleLepton()->p4();
+      p4s[ kBHadronic ]  = ttGenEvent_->hadronicDecayB()->p4();
+      p4s[ kQ1Hadronic ] = ttGenEvent_->hadronicDecayQuark()->p4();
+      p4s[ kQ2Hadronic ] = ttGenEvent_->hadronicDecayQuarkBar()->p4();
+      p4s[ kBeamParton ] = ( ttGenEvent_->initialPartons() )[0].p4();
+      boostInPlace( p4s, nParticles, topPairCmf.BoostToCM() );
 
       // build spin basis unit vectors
-      reco::Particle::Vector leptHelCmf( tLeptonicCmf.Vect().Unit() );
-      reco::Particle::Vector hadrHelCmf( tHadronicCmf.Vect().Unit() ); // = -leptHelCmf
-      reco::Particle::Vector beamBeamCmf( beamCmf.Vect().Unit() );
-      reco::Particle::Vector offDiagCmf( ( ( -beamBeamCmf+( 1.-topPairCmf.Gamma() ) * ( beamBeamCmf.Dot( leptHelCmf ) ) * leptHelCmf ) / ( std::sqrt( 1. - std::pow( beamBeamCmf.Dot( leptHelCmf ), 2. ) * ( 1. - std::pow( topPairCmf.Gamma(), 2. ) ) ) ) ).Unit() );                                                                                                                            // FIXME: use initial hadron instead of initial parton
+      const reco::Particle::Vector leptHelCmf( p4s[ kTLeptonic ].Vect().Unit() );
+      const reco::Particle::Vector hadrHelCmf( p4s[ kTHadronic ].Vect().Unit() ); // = -leptHelCmf
+      const reco::Particle::Vector beamBeamCmf( p4s[ kBeamParton ].Vect().Unit() );
+      const reco::Particle::Vector offDiagCmf( ( ( -beamBeamCmf+( 1.-topPairCmf.Gamma() ) * ( beamBeamCmf.Dot( leptHelCmf ) ) * leptHelCmf ) / ( std::sqrt( 1. - std::pow( beamBeamCmf.Dot( leptHelCmf ), 2. ) * ( 1. - std::pow( topPairCmf.Gamma(), 2. ) ) ) ) ).Unit() );                                                                                                                            // FIXME: use initial hadron instead of initial parton
 
       // boost 4-vectors to t(bar) rest frames
-      reco::Particle::LorentzVector lLeptonicTRest( ROOT::Math::VectorUtil::boost( lLeptonicCmf, tLeptonicCmf.BoostToCM() ) );
-      reco::Particle::LorentzVector bHadronicTRest( ROOT::Math::VectorUtil::boost( bHadronicCmf, tHadronicCmf.BoostToCM() ) );
-      reco::Particle::LorentzVector q1HadronicTRest( ROOT::Math::VectorUtil::boost( q1HadronicCmf, tHadronicCmf.BoostToCM() ) );
-      reco::Particle::LorentzVector q2HadronicTRest( ROOT::Math::VectorUtil::boost( q2HadronicCmf, tHadronicCmf.BoostToCM() ) );
-      reco::Particle::LorentzVector qHadronicTRest( q1HadronicTRest.energy() < q2HadronicTRest.energy() ? q1HadronicTRest : q2HadronicTRest );
+      // (the decay products of the hadronically decaying top are contiguous)
+      boostInPlace( p4s + kLLeptonic, 1, p4s[ kTLeptonic ].BoostToCM() );
+      boostInPlace( p4s + kBHadronic, 3, p4s[ kTHadronic ].BoostToCM() );
+      const reco::Particle::LorentzVector & qHadronicTRest( p4s[ kQ1Hadronic ].energy() < p4s[ kQ2Hadronic ].energy() ? p4s[ kQ1Hadronic ] : p4s[ kQ2Hadronic ] );
 
       // extract particle directions in t(bar) rest frames
-      reco::Particle::Vector lDirectionTRest( lLeptonicTRest.Vect().Unit() );
-      reco::Particle::Vector bDirectionTRest( bHadronicTRest.Vect().Unit() );
-      reco::Particle::Vector qDirectionTRest( qHadronicTRest.Vect().Unit() );
+      const reco::Particle::Vector lDirectionTRest( p4s[ kLLeptonic ].Vect().Unit() );
+      const reco::Particle::Vector bDirectionTRest( p4s[ kBHadronic ].Vect().Unit() );
+      const reco::Particle::Vector qDirectionTRest( qHadronicTRest.Vect().Unit() );
 
       // fill histograms
 
-      double cosPhiLB( lDirectionTRest.Dot( bDirectionTRest ) );
-      double cosPhiLQ( lDirectionTRest.Dot( qDirectionTRest ) );
-      histos1D_[ "massTt" ]->Fill( topPairCmf.mass() );
-      histos1D_[ "cosLB" ]->Fill( cosPhiLB );
-      histos1D_[ "cosLQ" ]->Fill( cosPhiLQ );
-
-      if ( useHelBasis_ ) {
-        double cosThetaTL_Hel( leptHelCmf.Dot( lDirectionTRest ) );
-        double cosThetaTB_Hel( hadrHelCmf.Dot( bDirectionTRest ) );
-        double cosThetaTQ_Hel( hadrHelCmf.Dot( qDirectionTRest ) );
-        histos1D_Hel_[ "cosTL" ]->Fill( cosThetaTL_Hel );
-        histos1D_Hel_[ "cosTB" ]->Fill( cosThetaTB_Hel );
-        histos1D_Hel_[ "cosTQ" ]->Fill( cosThetaTQ_Hel );
-        histos2D_Hel_[ "cosTBCosTL" ]->Fill( cosThetaTB_Hel, cosThetaTL_Hel );
-        histos2D_Hel_[ "cosTQCosTL" ]->Fill( cosThetaTQ_Hel, cosThetaTL_Hel );
-      }
-
-      if ( useBeamBasis_ ) {
-        double cosThetaTL_Beam( beamBeamCmf.Dot( lDirectionTRest ) );
-        double cosThetaTB_Beam( beamBeamCmf.Dot( bDirectionTRest ) );
-        double cosThetaTQ_Beam( beamBeamCmf.Dot( qDirectionTRest ) );
-        histos1D_Beam_[ "cosTL" ]->Fill( cosThetaTL_Beam );
-        histos1D_Beam_[ "cosTB" ]->Fill( cosThetaTB_Beam );
-        histos1D_Beam_[ "cosTQ" ]->Fill( cosThetaTQ_Beam );
-        histos2D_Beam_[ "cosTBCosTL" ]->Fill( cosThetaTB_Beam, cosThetaTL_Beam );
-        histos2D_Beam_[ "cosTQCosTL" ]->Fill( cosThetaTQ_Beam, cosThetaTL_Beam );
-      }
-
-      if ( useOffDiagBasis_ ) {
-        double cosThetaTL_OffDiag( offDiagCmf.Dot( lDirectionTRest ) );
-        double cosThetaTB_OffDiag( offDiagCmf.Dot( bDirectionTRest ) );
-        double cosThetaTQ_OffDiag( offDiagCmf.Dot( qDirectionTRest ) );
-        histos1D_OffDiag_[ "cosTL" ]->Fill( cosThetaTL_OffDiag );
-        histos1D_OffDiag_[ "cosTB" ]->Fill( cosThetaTB_OffDiag );
-        histos1D_OffDiag_[ "cosTQ" ]->Fill( cosThetaTQ_OffDiag );
-        histos2D_OffDiag_[ "cosTBCosTL" ]->Fill( cosThetaTB_OffDiag, cosThetaTL_OffDiag );
-        histos2D_OffDiag_[ "cosTQCosTL" ]->Fill( cosThetaTQ_OffDiag, cosThetaTL_OffDiag );
+      histos1D_[ kMassTt ]->Fill( topPairCmf.mass() );
+      histos1D_[ kCosLB ]->Fill( lDirectionTRest.Dot( bDirectionTRest ) );
+      histos1D_[ kCosLQ ]->Fill( lDirectionTRest.Dot( qDirectionTRest ) );
+
+      // spin axes of the leptonically and the hadronically decaying top per basis
+      const reco::Particle::Vector * axesLeptonic[ nBases ] = { &leptHelCmf, &beamBeamCmf, &offDiagCmf };
+      const reco::Particle::Vector * axesHadronic[ nBases ] = { &hadrHelCmf, &beamBeamCmf, &offDiagCmf };
+      for ( unsigned iBasis = 0; iBasis < nBases; ++iBasis ) {
+        if ( ! useBasis_[ iBasis ] ) continue;
+        const double cosThetaTL( axesLeptonic[ iBasis ]->Dot( lDirectionTRest ) );
+        const double cosThetaTB( axesHadronic[ iBasis ]->Dot( bDirectionTRest ) );
+        const double cosThetaTQ( axesHadronic[ iBasis ]->Dot( qDirectionTRest ) );
+        histosBasis1D_[ iBasis ][ kCosTL ]->Fill( cosThetaTL );
+        histosBasis1D_[ iBasis ][ kCosTB ]->Fill( cosThetaTB );
+        histosBasis1D_[ iBasis ][ kCosTQ ]->Fill( cosThetaTQ );
+        histosBasis2D_[ iBasis ][ kCosTBCosTL ]->Fill( cosThetaTB, cosThetaTL );
+        histosBasis2D_[ iBasis ][ kCosTQCosTL ]->Fill( cosThetaTQ, cosThetaTL );
       }
 
     } // Semi-leptonic signal event
@@ -335,28 +325,13 @@ void AnalyzeSpinCorrelations::endJob()
   fit2LQ.SetParameter( 3,kappaQ_ );
   fit2LQ.FixParameter( 3,kappaQ_ );
 
-  if ( useHelBasis_ ) {
-    histos1D_Hel_[ "cosTL" ]->Fit( &fit1L );
-    histos1D_Hel_[ "cosTB" ]->Fit( &fit1B );
-    histos1D_Hel_[ "cosTQ" ]->Fit( &fit1Q );
-    histos2D_Hel_[ "cosTBCosTL" ]->Fit( &fit2LB );
-    histos2D_Hel_[ "cosTQCosTL" ]->Fit( &fit2LQ );
-  }
-
-  if ( useBeamBasis_ ) {
-    histos1D_Beam_[ "cosTL" ]->Fit( &fit1L );
-    histos1D_Beam_[ "cosTB" ]->Fit( &fit1B );
-    histos1D_Beam_[ "cosTQ" ]->Fit( &fit1Q );
-    histos2D_Beam_[ "cosTBCosTL" ]->Fit( &fit2LB );
-    histos2D_Beam_[ "cosTQCosTL" ]->Fit( &fit2LQ );
-  }
-
-  if ( useOffDiagBasis_ ) {
-    histos1D_OffDiag_[ "cosTL" ]->Fit( &fit1L );
-    histos1D_OffDiag_[ "cosTB" ]->Fit( &fit1B );
-    histos1D_OffDiag_[ "cosTQ" ]->Fit( &fit1Q );
-    histos2D_OffDiag_[ "cosTBCosTL" ]->Fit( &fit2LB );
-    histos2D_OffDiag_[ "cosTQCosTL" ]->Fit( &fit2LQ );
+  for ( unsigned iBasis = 0; iBasis < nBases; ++iBasis ) {
+    if ( ! useBasis_[ iBasis ] ) continue;
+    histosBasis1D_[ iBasis ][ kCosTL ]->Fit( &fit1L );
+    histosBasis1D_[ iBasis ][ kCosTB ]->Fit( &fit1B );
+    histosBasis1D_[ iBasis ][ kCosTQ ]->Fit( &fit1Q );
+    histosBasis2D_[ iBasis ][ kCosTBCosTL ]->Fit( &fit2LB );
+    histosBasis2D_[ iBasis ][ kCosTQCosTL ]->Fit( &fit2LQ );
   }
 
 }